@@ -0,0 +1,245 @@
+#!/usr/bin/perl -w
+
+# FriBidi - Library of BiDi algorithm
+# Copyright (C) 1999 Dov Grobgeld
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Library General Public
+# License as published by the Free Software Foundation; either
+# version 2 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+# Library General Public License for more details.
+#
+# You should have received a copy of the GNU Library General Public
+# License along with this library; if not, write to the
+# Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+# Boston, MA 02111-1307, USA.
+#
+
+######################################################################
+#  This is a Perl program for automatically building the conversion
+#  tables of the 8-bit character sets in fribidi_char_sets.c. For
+#  every character set it writes a 256 entry table to Unicode, and a
+#  two level table from the Basic Multilingual Plane back to the
+#  character set: an index of 256 pages by the high byte of the
+#  character, and the pages of 256 bytes that are in use.
+#
+#  The mappings are defined below as lists of ranges and of pairs,
+#  applied in order, so that a later entry overrides an earlier one.
+######################################################################
+
+use strict;
+
+my $out_file = "fribidi_char_sets_tables.i";
+
+# The byte written for characters that the set has no code for.
+my $unknown = 0xBF;
+
+# The byte read for codes that the set doesn't define.
+my $undefined = ord('?');
+
+# [from, to, first unicode] : from..to map to first..
+my %to_unicode = (
+    iso8859_6 => [ [0x00, 0xFF, 0x0000],
+		   [0xC1, 0xF2, 0x0621] ],
+    iso8859_8 => [ [0x00, 0xDA, 0x0000],
+		   [0xDB, 0xFF, -1],
+		   [0xE0, 0xFA, 0x05D0],
+		   [0xFD, 0xFD, 0x200E], [0xFE, 0xFE, 0x200F],
+		   [0xDB, 0xDB, 0x202D], [0xDC, 0xDC, 0x202E],
+		   [0xFB, 0xFB, 0x202A], [0xFC, 0xFC, 0x202B],
+		   [0xDD, 0xDD, 0x202C] ],
+    cp1255 => [ [0x00, 0xFF, 0x0000],
+		[0x80, 0xBF, [
+		  0x20AC,  0x81,0x201A,0x0192,0x201E,0x2026,0x2020,0x2021,
+		  0x02C6,0x2030,  0x8a,0x2039,  0x8c,  0x8d,  0x8e,  0x8f,
+		    0x90,0x2018,0x2019,0x201C,0x201D,0x2022,0x2013,0x2014,
+		  0x02DC,0x2122,  0x9a,0x203A,  0x9c,  0x9d,  0x9e,  0x9f,
+		  0x00A0,0x00A1,0x00A2,0x00A3,0x20AA,0x00A5,0x00A6,0x00A7,
+		  0x00A8,0x00A9,0x00D7,0x00AB,0x00AC,0x00AD,0x00AE,0x00AF,
+		  0x00B0,0x00B1,0x00B2,0x00B3,0x00B4,0x00B5,0x00B6,0x00B7,
+		  0x00B8,0x00B9,0x00F7,0x00BB,0x00BC,0x00BD,0x00BE,0x00BF ]],
+		[0xC0, 0xD3, 0x05B0],
+		[0xD4, 0xD8, 0x05F0],
+		[0xE0, 0xFA, 0x05D0] ],
+    cp1256 => [ [0x00, 0xFF, 0x0000],
+		[0x80, 0xFF, [
+		  0x20AC,0x067E,0x201A,0x0192,0x201E,0x2026,0x2020,0x2021,
+		  0x02C6,0x2030,0x0679,0x2039,0x0152,0x0686,0x0698,0x0688,
+		  0x06AF,0x2018,0x2019,0x201C,0x201D,0x2022,0x2013,0x2014,
+		  0x06A9,0x2122,0x0691,0x203A,0x0153,0x200C,0x200D,0x06BA,
+		  0x00A0,0x060C,0x00A2,0x00A3,0x00A4,0x00A5,0x00A6,0x00A7,
+		  0x00A8,0x00A9,0x06BE,0x00AB,0x00AC,0x00AD,0x00AE,0x00AF,
+		  0x00B0,0x00B1,0x00B2,0x00B3,0x00B4,0x00B5,0x00B6,0x00B7,
+		  0x00B8,0x00B9,0x061B,0x00BB,0x00BC,0x00BD,0x00BE,0x061F,
+		  0x06C1,0x0621,0x0622,0x0623,0x0624,0x0625,0x0626,0x0627,
+		  0x0628,0x0629,0x062A,0x062B,0x062C,0x062D,0x062E,0x062F,
+		  0x0630,0x0631,0x0632,0x0633,0x0634,0x0635,0x0636,0x00D7,
+		  0x0637,0x0638,0x0639,0x063A,0x0640,0x0641,0x0642,0x0643,
+		  0x00E0,0x0644,0x00E2,0x0645,0x0646,0x0647,0x0648,0x00E7,
+		  0x00E8,0x00E9,0x00EA,0x00EB,0x0649,0x064A,0x00EE,0x00EF,
+		  0x064B,0x064C,0x064D,0x064E,0x00F4,0x064F,0x0650,0x00F7,
+		  0x0651,0x00F9,0x0652,0x00FB,0x00FC,0x200E,0x200F,0x00ff ]] ],
+    # 0x80-0xA0 and 0xFF are mapped down to 0x00-0x20 and 0x7F.
+    # 0xEC-0xEF are not defined and are kept as they are.
+    isiri_3342 => [ [0x00, 0xFF, 0x0000],
+		    [0x80, 0xA0, 0x0000],
+		    [0xA1, 0xFE, [
+		            0x200C,0x200D,0x0021,0x00A4,0x066A,0x002E,0x066C,
+		      0x0029,0x0028,0x00D7,0x002B,0x060C,0x002D,0x066B,0x002F,
+		      0x06F0,0x06F1,0x06F2,0x06F3,0x06F4,0x06F5,0x06F6,0x06F7,
+		      0x06F8,0x06F9,0x003A,0x061B,0x003C,0x003D,0x003E,0x061F,
+		      0x0622,0x0627,0x0621,0x0628,0x067E,0x062A,0x062B,0x062C,
+		      0x0686,0x062D,0x062E,0x062F,0x0630,0x0631,0x0632,0x0698,
+		      0x0633,0x0634,0x0635,0x0636,0x0637,0x0638,0x0639,0x063A,
+		      0x0641,0x0642,0x06A9,0x06AF,0x0644,0x0645,0x0646,0x0648,
+		      0x0647,0x06CC,0x005D,0x005B,0x007D,0x007B,0x00AB,0x00BB,
+		      0x002A,0x0640,0x007C,0x005C,0x00EC,0x00ED,0x00EE,0x00EF,
+		      0x064E,0x0650,0x064F,0x064B,0x064D,0x064C,0x0651,0x0652,
+		      0x0623,0x0624,0x0625,0x0626,0x0629,0x0643,0x064A ]],
+		    [0xFF, 0xFF, 0x007F] ],
+    );
+
+# [first unicode, last unicode, first code] : first..last map to code..
+# Characters that aren't listed are written as $unknown.
+my %from_unicode = (
+    iso8859_6 => [ [0x0000, 0x00FF, 0x00],
+		   [0x0621, 0x0652, 0xC1],
+		   [0x060C, 0x060C, 0xAC], [0x061B, 0x061B, 0xBB],
+		   [0x061F, 0x061F, 0xBF] ],
+    iso8859_8 => [ [0x0000, 0x007F, 0x00],
+		   [0x05D0, 0x05EA, 0xE0],
+		   [0x200F, 0x200F, 0xFE], [0x200E, 0x200E, 0xFD],
+		   [0x202E, 0x202E, 0xDC], [0x202D, 0x202D, 0xDB],
+		   [0x202B, 0x202B, 0xFC], [0x202A, 0x202A, 0xFB],
+		   [0x202C, 0x202C, 0xDD] ],
+    cp1255 => [ [0x0000, 0x00FF, 0x00],
+		[0x05D0, 0x05EA, 0xE0],
+		[0x05B0, 0x05C3, 0xC0],
+		[0x05F0, 0x05F4, 0xD4] ],
+    cp1256 => [ [0x0000, 0x00FF, 0x00],
+		[0x0621, 0x0636, 0xC1],
+		map { [$_->[0], $_->[0], $_->[1]] } (
+		  [0x0152, 0x8C], [0x0153, 0x9C], [0x0192, 0x83], [0x02C6, 0x88],
+		  [0x060C, 0xA1], [0x061B, 0xBA], [0x061F, 0xBF], [0x0637, 0xD8],
+		  [0x0638, 0xD9], [0x0639, 0xDA], [0x063A, 0xDB], [0x0640, 0xDC],
+		  [0x0641, 0xDD], [0x0642, 0xDE], [0x0643, 0xDF], [0x0644, 0xE1],
+		  [0x0645, 0xE3], [0x0646, 0xE4], [0x0647, 0xE5], [0x0648, 0xE6],
+		  [0x0649, 0xEC], [0x064A, 0xED], [0x064B, 0xF0], [0x064C, 0xF1],
+		  [0x064D, 0xF2], [0x064E, 0xF3], [0x064F, 0xF5], [0x0650, 0xF6],
+		  [0x0651, 0xF8], [0x0652, 0xFA], [0x0679, 0x8A], [0x067E, 0x81],
+		  [0x0686, 0x8D], [0x0688, 0x8F], [0x0691, 0x9A], [0x0698, 0x8E],
+		  [0x06A9, 0x98], [0x06AF, 0x90], [0x06BA, 0x9F], [0x06BE, 0xAA],
+		  [0x06C1, 0xC0], [0x200C, 0x9D], [0x200D, 0x9E], [0x200E, 0xFD],
+		  [0x200F, 0xFE], [0x2013, 0x96], [0x2014, 0x97], [0x2018, 0x91],
+		  [0x2019, 0x92], [0x201A, 0x82], [0x201C, 0x93], [0x201D, 0x94],
+		  [0x201E, 0x84], [0x2020, 0x86], [0x2021, 0x87], [0x2022, 0x95],
+		  [0x2026, 0x85], [0x2030, 0x89], [0x2039, 0x8B], [0x203A, 0x9B],
+		  [0x20AC, 0x80], [0x2122, 0x99]) ],
+    isiri_3342 => [ [0x0000, 0x00FF, 0x00],
+		    map { [$_->[0], $_->[0], $_->[1]] } (
+		      [0x060C, 0xAC], [0x061B, 0xBB], [0x061F, 0xBF], [0x0621, 0xC2],
+		      [0x0622, 0xC0], [0x0623, 0xF8], [0x0624, 0xF9], [0x0625, 0xFA],
+		      [0x0626, 0xFB], [0x0627, 0xC1], [0x0628, 0xC3], [0x0629, 0xFC],
+		      [0x062A, 0xC5], [0x062B, 0xC6], [0x062C, 0xC7], [0x062D, 0xC9],
+		      [0x062E, 0xCA], [0x062F, 0xCB], [0x0630, 0xCC], [0x0631, 0xCD],
+		      [0x0632, 0xCE], [0x0633, 0xD0], [0x0634, 0xD1], [0x0635, 0xD2],
+		      [0x0636, 0xD3], [0x0637, 0xD4], [0x0638, 0xD5], [0x0639, 0xD6],
+		      [0x063A, 0xD7], [0x0640, 0xE9], [0x0641, 0xD8], [0x0642, 0xD9],
+		      [0x0643, 0xFD], [0x0644, 0xDC], [0x0645, 0xDD], [0x0646, 0xDE],
+		      [0x0647, 0xE0], [0x0648, 0xDF], [0x064A, 0xFE], [0x064B, 0xF3],
+		      [0x064C, 0xF5], [0x064D, 0xF4], [0x064E, 0xF0], [0x064F, 0xF2],
+		      [0x0650, 0xF1], [0x0651, 0xF6], [0x0652, 0xF7], [0x066A, 0xA5],
+		      [0x066B, 0xAE], [0x066C, 0xA7], [0x067E, 0xC4], [0x0686, 0xC8],
+		      [0x0698, 0xCF], [0x06A9, 0xDA], [0x06AF, 0xDB], [0x06CC, 0xE1],
+		      [0x06F0, 0xB0], [0x06F1, 0xB1], [0x06F2, 0xB2], [0x06F3, 0xB3],
+		      [0x06F4, 0xB4], [0x06F5, 0xB5], [0x06F6, 0xB6], [0x06F7, 0xB7],
+		      [0x06F8, 0xB8], [0x06F9, 0xB9], [0x200C, 0xA1], [0x200D, 0xA2]) ],
+    );
+
+my @charsets = qw(iso8859_6 iso8859_8 cp1255 cp1256 isiri_3342);
+
+open(OUT, ">$out_file") or die "Can't write $out_file: $!\n";
+
+print OUT <<__;
+/*======================================================================
+//  This file was automatically created by the perl script
+//  CreateCharSetTables.pl. It is included by fribidi_char_sets.c.
+//----------------------------------------------------------------------*/
+
+__
+
+for my $cs (@charsets) {
+    # The table to Unicode
+    my @tab;
+    for my $range (@{$to_unicode{$cs}}) {
+	my ($from, $to, $first) = @$range;
+	die "$cs: wrong length of list at $from\n"
+	    if ref $first && @$first != $to - $from + 1;
+	for my $ch ($from..$to) {
+	    if (ref $first) {
+		$tab[$ch] = $first->[$ch - $from];
+	    } elsif ($first < 0) {
+		$tab[$ch] = $undefined;
+	    } else {
+		$tab[$ch] = $first + $ch - $from;
+	    }
+	}
+    }
+    die "$cs: table to Unicode is not complete\n" if grep {!defined} @tab[0..255];
+
+    print OUT "static const FriBidiChar fribidi_${cs}_to_unicode_table[256] = {\n";
+    for my $row (0..31) {
+	print OUT "  ", join(",", map {sprintf("0x%04X", $_)} @tab[$row*8..$row*8+7]),
+	    ($row < 31 ? ",\n" : "\n");
+    }
+    print OUT "};\n\n";
+
+    # The tables from Unicode. Each page is stored once, and page 0 of
+    # the list is the one that maps everything to $unknown.
+    my %map;
+    for my $range (@{$from_unicode{$cs}}) {
+	my ($first, $last, $code) = @$range;
+	for my $uch ($first..$last) {
+	    $map{$uch} = $code + $uch - $first;
+	}
+    }
+
+    my @pages = (join(",", ($unknown) x 256));
+    my %page_num = ($pages[0] => 0);
+    my @index;
+    for my $hi (0..255) {
+	my $page = join(",", map { defined $map{$hi*256+$_} ? $map{$hi*256+$_}
+				       : $unknown } (0..255));
+	if (!defined $page_num{$page}) {
+	    $page_num{$page} = scalar @pages;
+	    push @pages, $page;
+	}
+	push @index, $page_num{$page} * 256;
+    }
+
+    print OUT "static const gint32 fribidi_unicode_to_${cs}_index[256] = {\n";
+    for my $row (0..15) {
+	print OUT "  ", join(",", map {sprintf("%4d", $_)} @index[$row*16..$row*16+15]),
+	    ($row < 15 ? ",\n" : "\n");
+    }
+    print OUT "};\n\n";
+
+    # The pages are padded so that they can be read four bytes at a time
+    print OUT "static const guint8 fribidi_unicode_to_${cs}_pages[",
+	scalar(@pages), " * 256 + 3] = {\n";
+    for my $p (0..$#pages) {
+	my @bytes = split(/,/, $pages[$p]);
+	print OUT "  /* Page $p */\n";
+	for my $row (0..15) {
+	    print OUT "  ", join(",", map {sprintf("0x%02X", $_)} @bytes[$row*16..$row*16+15]),
+		",\n";
+	}
+    }
+    print OUT "  0, 0, 0\n};\n\n";
+}
+
+close(OUT);
@@ -0,0 +1,60 @@
+#!/usr/bin/perl -w
+
+# FriBidi - Library of BiDi algorithm
+# Copyright (C) 1999 Dov Grobgeld
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Library General Public
+# License as published by the Free Software Foundation; either
+# version 2 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+# Library General Public License for more details.
+#
+# You should have received a copy of the GNU Library General Public
+# License along with this library; if not, write to the
+# Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+# Boston, MA 02111-1307, USA.
+#
+
+######################################################################
+#  This is a Perl program for automatically building the constant
+#  tables of the SIMD kernels in fribidi_simd.c.
+#
+#  utf8_compact_shuffle holds, for each mask of the ASCII characters
+#  of a block of eight 16 bit UTF-8 forms, the byte shuffle that drops
+#  the unused high byte of the ASCII ones. Unused lanes are 0x80, which
+#  the shuffle turns into zero.
+######################################################################
+
+use strict;
+
+my $out_file = "fribidi_simd_tables.i";
+
+open(OUT, ">$out_file") or die "Can't write $out_file: $!\n";
+
+print OUT <<__;
+/*======================================================================
+//  This file was automatically created by the perl script
+//  CreateSimdTables.pl. It is included by fribidi_simd.c.
+//----------------------------------------------------------------------*/
+
+static const guint8 utf8_compact_shuffle[256][16] = {
+__
+
+for my $mask (0..255) {
+    my @shuffle;
+    for my $k (0..7) {
+	push @shuffle, 2 * $k;
+	push @shuffle, 2 * $k + 1 unless $mask & (1 << $k);
+    }
+    push @shuffle, 0x80 while @shuffle < 16;
+    print OUT "  { ", join(",", map {sprintf("0x%02X", $_)} @shuffle),
+	($mask < 255 ? " },\n" : " }\n");
+}
+
+print OUT "};\n";
+
+close(OUT);
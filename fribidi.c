@@ -17,126 +17,72 @@
  * Boston, MA 02111-1307, USA.
  */
 #include <glib.h>
-#include "fribidi.h"
+#include "fribidi_private.h"
+#include <string.h>
 #ifndef NO_STDIO
 #include <stdio.h>
 #endif
-
-#ifndef NO_STDIO
-#define DBG(s) if (fribidi_debug) { fprintf(stderr, s); }
-#else
-#define DBG(s)
+#ifdef FRIBIDI_X86_SIMD
+#include <emmintrin.h>
 #endif
 
-/*======================================================================
-// Typedef for the run-length list.
-//----------------------------------------------------------------------*/
-typedef struct _TypeLink TypeLink;
-
-struct _TypeLink {
-  TypeLink *prev;
-  TypeLink *next;
-  FriBidiCharType type;
-  gint pos;
-  gint len;
-  gint level;
-};
-
 typedef struct {
   FriBidiChar key;
   FriBidiChar value;
 } key_value_t;
 
-/* Global variables */
-gboolean fribidi_debug = FALSE;
-
+/* The debug output is now the trace of the calling thread */
 void fribidi_set_debug(gboolean debug)
 {
-  fribidi_debug = debug;
-}
-
-static gint bidi_string_strlen(FriBidiChar *str)
-{
-  gint len = 0;
-
-  while(*str++)
-    len++;
-  
-  return len;
+  fribidi_trace_enable(debug);
 }
 
+/* The reversals are done by the vector kernels of fribidi_simd.c */
 static void bidi_string_reverse(FriBidiChar *str, gint len)
 {
-  gint i;
-  for (i=0; i<len/2; i++)
-    {
-      FriBidiChar tmp = str[i];
-      str[i] = str[len-1-i];
-      str[len-1-i] = tmp;
-    }
+  fribidi_reverse_u32(str, len);
 }
 
 static void
 int16_array_reverse(guint16 *arr, gint len)
 {
-  gint i;
-  for (i=0; i<len/2; i++)
-    {
-      guint16 tmp = arr[i];
-      arr[i] = arr[len-1-i];
-      arr[len-1-i] = tmp;
-    }
+  fribidi_reverse_u16(arr, len);
 }
 
-#ifndef USE_SIMPLE_MALLOC
-static TypeLink *free_type_links = NULL;
-#endif
-
-static TypeLink *new_type_link(void)
+/*======================================================================
+//  fill_index_ramp() fills arr with the len values start, start+step,
+//  start+2*step, ... where step is 1 or -1. This is how the position
+//  maps are written for every run.
+//----------------------------------------------------------------------*/
+static void
+fill_index_ramp(guint16 *arr, gint len, gint start, gint step)
 {
-  TypeLink *link;
-  
-#ifdef USE_SIMPLE_MALLOC
-  link = g_malloc(sizeof(TypeLink));
-#else
-  if (free_type_links)
-    {
-      link = free_type_links;
-      free_type_links = free_type_links->next;
-    }
-  else
-    {
-      static GMemChunk *mem_chunk = NULL;
+  gint i = 0;
 
-      if (!mem_chunk)
-       mem_chunk = g_mem_chunk_new ("TypeLinkList",
-                                    sizeof (TypeLink),
-                                    sizeof (TypeLink) * 128,
-                                    G_ALLOC_ONLY);
+#ifdef FRIBIDI_X86_SIMD
+  if (len >= 16)
+    {
+      __m128i ramp = _mm_add_epi16(_mm_set1_epi16(start),
+				   _mm_mullo_epi16(_mm_set1_epi16(step),
+						   _mm_setr_epi16(0, 1, 2, 3,
+								  4, 5, 6, 7)));
+      __m128i inc = _mm_set1_epi16(8 * step);
 
-      link = g_chunk_new (TypeLink, mem_chunk);
+      for (; i + 8 <= len; i += 8)
+	{
+	  _mm_storeu_si128((__m128i*)(arr + i), ramp);
+	  ramp = _mm_add_epi16(ramp, inc);
+	}
     }
 #endif
-  
-  link->len = 0;
-  link->pos = 0;
-  link->level = 0;
-  link->next = NULL;
-  link->prev = NULL;
-  return link;
-}
 
-static void free_type_link(TypeLink *link)
-{
-#ifdef USE_SIMPLE_MALLOC
-  g_free(link);
-#else
-  link->next = free_type_links;
-  free_type_links = link;
-#endif
+  for (; i<len; i++)
+    arr[i] = start + i * step;
 }
 
-static TypeLink *run_length_encode_types(gint *char_type, gint type_len)
+static TypeLink *run_length_encode_types(FriBidiContext *ctx,
+					 gint *char_type,
+					 gint type_len)
 {
   TypeLink *list = NULL;
   TypeLink *last;
@@ -145,7 +91,7 @@ static TypeLink *run_length_encode_types(gint *char_type, gint type_len)
   gint len, pos, i;
 
   /* Add the starting link */
-  list = new_type_link();
+  list = fribidi_type_link_new(ctx);
   list->type = FRIBIDI_TYPE_SOT;
   list->len = 0;
   list->pos = 0;
@@ -161,10 +107,11 @@ static TypeLink *run_length_encode_types(gint *char_type, gint type_len)
 	{
 	  if (pos>=0)
 	    {
-	      link = new_type_link();
+	      link = fribidi_type_link_new(ctx);
 	      link->type = type;
 	      link->pos = pos;
 	      link->len = len;
+	      STATS_ADD(ctx, runs_created, 1);
              last->next = link;
              link->prev = last;
 	      last = last->next;
@@ -179,7 +126,7 @@ static TypeLink *run_length_encode_types(gint *char_type, gint type_len)
     }
 
   /* Add the ending link */
-  link = new_type_link();
+  link = fribidi_type_link_new(ctx);
   link->type = FRIBIDI_TYPE_EOT;
   link->len = 0;
   link->pos = type_len;
@@ -195,18 +142,21 @@ static TypeLink *run_length_encode_types(gint *char_type, gint type_len)
 #define RL_POS(list) (list)->pos
 #define RL_LEVEL(list) (list)->level
 
-static void compact_list(TypeLink *list)
+static void compact_list(FriBidiContext *ctx,
+			 TypeLink *list)
 {
   while(list)
     {
       if (list->prev
-	  && RL_TYPE(list->prev) == RL_TYPE(list))
+	  && RL_TYPE(list->prev) == RL_TYPE(list)
+	  && RL_LEVEL(list->prev) == RL_LEVEL(list))
 	{
           TypeLink *next = list->next;
 	  list->prev->next = list->next;
 	  list->next->prev = list->prev;
 	  RL_LEN(list->prev) = RL_LEN(list->prev) + RL_LEN(list);
-          free_type_link(list);
+          fribidi_type_link_free(ctx, list);
+	  STATS_ADD(ctx, compact_merges, 1);
 	  list = next;
       }
       else
@@ -258,69 +208,33 @@ static void compact_list(TypeLink *list)
        }
 
 /*======================================================================
-//  For debugging, define some macros for printing the types and the
-//  levels.
+//  The trace of the text and of the run length list, which TRACE()
+//  records when tracing is on. fribidi_trace_print() prints them as
+//  the text, the runs and the resolved levels and types.
 //----------------------------------------------------------------------*/
-#ifndef NO_STDIO
-static void print_types_re(TypeLink *pp)
-{
-  while(pp)
-    {
-      printf("%d:%c(%d)[%d] ", RL_POS(pp), RL_TYPE(pp), RL_LEN(pp), RL_LEVEL(pp));
-      pp = pp->next;
-    }
-  printf("\n");
-}
-
-static void print_resolved_levels(TypeLink *pp)
+#ifdef FRIBIDI_ENABLE_TRACE
+static void trace_string(FriBidiChar *str, gint len, FriBidiCharType base_dir)
 {
-  while(pp)
-    {
-      gint i;
-      for (i=0; i<RL_LEN(pp); i++)
-	printf("%d", RL_LEVEL(pp));
-      pp = pp->next;
-    }
-  printf("\n");
-}
+  gint i;
 
-static void print_resolved_types(TypeLink *pp)
-{
-  while(pp)
-    {
-      gint i;
-      for (i=0; i<RL_LEN(pp); i++)
-	{
-	  gchar ch;
-	  FriBidiCharType type = RL_TYPE(pp);
-         
-	  /* Convert the type to something readable */
-	  if (type == FRIBIDI_TYPE_R)
-	    ch = 'R';
-	  else if (type == FRIBIDI_TYPE_L)
-	    ch = 'L';
-	  else if (type == FRIBIDI_TYPE_E)
-	    ch = 'E';
-	  else if (type == FRIBIDI_TYPE_EN)
-	    ch = 'n';
-	  else if (type == FRIBIDI_TYPE_N)
-	    ch = 'N';
-	  else
-	    ch = '?';
-	  
-	  printf("%c", ch);
-	}
-      pp = pp->next;
-    }
-  printf("\n");
+  fribidi_trace_record(FRIBIDI_TRACE_PARAGRAPH, 0, len, base_dir, 0);
+  for (i=0; i<len; i+=3)
+    fribidi_trace_record(FRIBIDI_TRACE_CHARS, MIN(len - i, 3), str[i],
+			 i + 1 < len ? str[i + 1] : 0,
+			 i + 2 < len ? str[i + 2] : 0);
 }
 
-static void print_bidi_string(FriBidiChar *str)
+static void trace_runs(FriBidiTraceSnapshot snapshot, TypeLink *list)
 {
-  gint i;
-  for (i=0; i<bidi_string_strlen(str); i++)
-    printf("%c", str[i]);
-  printf("\n");
+  TypeLink *pp;
+  gint num_runs = 0;
+
+  for (pp = list; pp; pp = pp->next)
+    num_runs++;
+  fribidi_trace_record(FRIBIDI_TRACE_RUNS, snapshot, num_runs, 0, 0);
+  for (pp = list; pp; pp = pp->next)
+    fribidi_trace_record(FRIBIDI_TRACE_RUN, RL_TYPE(pp), RL_POS(pp),
+			 RL_LEN(pp), RL_LEVEL(pp));
 }
 #endif
 
@@ -357,99 +271,25 @@ search_rl_for_strong(TypeLink *pos,
 }
 
 /*======================================================================
-//  This function should follow the Unicode specification closely!
-//
-//  It is still lacking the support for <RLO> and <LRO>.
+//  resolve_level_run() applies the weak, the neutral and the implicit
+//  rules (phases 4 to 6) to a level run, i.e. to the links between sot
+//  and the end of the list, that all have the embedding level level.
+//  The types of the sot link and of the last link of the list are
+//  used as sor and eor. last_strong is the direction that the strong
+//  types are initially assumed to have.
 //----------------------------------------------------------------------*/
 static void
-fribidi_analyse_string(/* input */
-		       FriBidiChar *str,
-		       gint len,
-		       FriBidiCharType *pbase_dir,
-		       /* output */
-                      TypeLink **ptype_rl_list,
-		       gint *pmax_level)
+resolve_level_run(FriBidiContext *ctx,
+		  TypeLink *sot,
+		  gint level,
+		  gint last_strong)
 {
-  gint base_level, base_dir;
-  gint max_level;
-  gint i;
-  gint *char_type;
-  gint prev_last_strong, last_strong;
-  TypeLink *type_rl_list, *pp;
-
-  /* Determinate character types */
-  char_type = g_new(gint, len);
-  for (i=0; i<len; i++)
-    char_type[i] = fribidi_get_type(str[i]);
-
-  /* Run length encode the character types */
-  type_rl_list = run_length_encode_types(char_type, len);
-  g_free(char_type);
-
-  /* Find the base level */
-  if (*pbase_dir == FRIBIDI_TYPE_L)
-    {
-      base_dir = FRIBIDI_TYPE_L;
-      base_level = 0;
-    }
-  else if (*pbase_dir == FRIBIDI_TYPE_R)
-    {
-      base_dir = FRIBIDI_TYPE_R;
-      base_level = 1;
-    }
+  TypeLink *pp;
+  STATS_TIMER(t)
 
-  /* Search for first strong character and use its direction as base
-     direciton */
-  else
-    {
-      base_level = 0; /* Default */
-      base_dir = FRIBIDI_TYPE_N;
-      for (pp = type_rl_list; pp; pp = pp->next)
-	{
-	  if (RL_TYPE(pp) == FRIBIDI_TYPE_R)
-	    {
-	      base_level = 1;
-	      base_dir = FRIBIDI_TYPE_R;
-	      break;
-	    }
-	  else if (RL_TYPE(pp) == FRIBIDI_TYPE_L)
-	    {
-	      base_level = 0;
-	      base_dir = FRIBIDI_TYPE_L;
-	      break;
-	    }
-	}
-    
-      /* If no strong base_dir was found, resort to the weak direction
-       * that was passed on input.
-       */
-      if (base_dir == FRIBIDI_TYPE_N)
-	{
-	  if (*pbase_dir == FRIBIDI_TYPE_WR)
-	    {
-	      base_dir = FRIBIDI_TYPE_RTL;
-	      base_level = 1;
-	    }
-	  else if (*pbase_dir == FRIBIDI_TYPE_WL)
-	    {
-	      base_dir = FRIBIDI_TYPE_LTR;
-	      base_level = 0;
-	    }
-	}
-    }
-  
-  /* 1. Explicit Levels and Directions. TBD! */
-  compact_list(type_rl_list);
-  
-  /* 2. Explicit Overrides. TBD! */
-  compact_list(type_rl_list);
-  
-  /* 3. Terminating Embeddings and overrides. TBD! */
-  compact_list(type_rl_list);
-  
   /* 4. Resolving weak types */
-  last_strong = base_dir;
-  for (pp = type_rl_list->next; pp->next; pp = pp->next)
+  TRACE_PHASE(FRIBIDI_PHASE_WEAK);
+  for (pp = sot->next; pp->next; pp = pp->next)
     {
       gint prev_type = RL_TYPE(pp->prev);
       gint this_type = RL_TYPE(pp);
@@ -526,14 +366,15 @@ fribidi_analyse_string(/* input */
       && last_strong == FRIBIDI_TYPE_L)             
     RL_TYPE(pp->prev) = FRIBIDI_TYPE_L;
 
-  compact_list(type_rl_list);
+  compact_list(ctx, sot);
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_WEAK);
   
   /* 5. Resolving Neutral Types */
-  DBG("Resolving neutral types.\n");
+  TRACE_PHASE(FRIBIDI_PHASE_NEUTRAL);
 
   /* We can now collapse all separators and other neutral types to
      plain neutrals */
-  for (pp = type_rl_list->next; pp->next; pp = pp->next)
+  for (pp = sot->next; pp->next; pp = pp->next)
     {
       gint this_type = RL_TYPE(pp);
 
@@ -546,9 +387,9 @@ fribidi_analyse_string(/* input */
 	RL_TYPE(pp) = FRIBIDI_TYPE_N;
     }
     
-  compact_list(type_rl_list);
+  compact_list(ctx, sot);
   
-  for (pp = type_rl_list->next; pp->next; pp = pp->next)
+  for (pp = sot->next; pp->next; pp = pp->next)
     {
       gint prev_type = RL_TYPE(pp->prev);
       gint this_type = RL_TYPE(pp);
@@ -575,250 +416,2179 @@ fribidi_analyse_string(/* input */
 	}
     }
 
-  compact_list(type_rl_list);
-#ifndef NO_STDIO
-  if (fribidi_debug)
-      print_types_re(type_rl_list);
-#endif
+  compact_list(ctx, sot);
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_NEUTRAL);
+  TRACE(trace_runs(FRIBIDI_TRACE_TYPES, sot));
   
   /* 6. Resolving Implicit levels */
-  DBG("Resolving implicit levels.\n");
-  {
-    gint level = base_level;
-    max_level = base_level;
-    
-    for (pp = type_rl_list->next; pp->next; pp = pp->next)
-      {
-	gint this_type = RL_TYPE(pp);
-
-	/* This code should be expanded to handle explicit directions! */
-
-	/* Even */
-	if (level % 2 == 0)
-	  {
-	    if (this_type == FRIBIDI_TYPE_R)
-	      RL_LEVEL(pp) = level + 1;
-	    else if (this_type == FRIBIDI_TYPE_AN)
-	      RL_LEVEL(pp) = level + 2;
-	    else if (RL_TYPE(pp->prev) != FRIBIDI_TYPE_L && this_type == FRIBIDI_TYPE_EN)
-	      RL_LEVEL(pp) = level + 2;
-	    else
-	      RL_LEVEL(pp) = level;
-	  }
-	/* Odd */
-	else
-	  {
-	    if (   this_type == FRIBIDI_TYPE_L
-		|| this_type == FRIBIDI_TYPE_AN
-		|| this_type == FRIBIDI_TYPE_EN)
-	      RL_LEVEL(pp) = level+1;
-	    else
-	      RL_LEVEL(pp) = level;
-	  }
-
-	if (RL_LEVEL(pp) > max_level)
-	  max_level = RL_LEVEL(pp);
-      }
-  }
-  
-  compact_list(type_rl_list);
-
-#ifndef NO_STDIO
-  if (fribidi_debug)
+  TRACE_PHASE(FRIBIDI_PHASE_LEVELS);
+  for (pp = sot->next; pp->next; pp = pp->next)
     {
-      print_bidi_string(str);
-      print_resolved_levels(type_rl_list);
-      print_resolved_types(type_rl_list);
+      gint this_type = RL_TYPE(pp);
+
+      /* Even */
+      if (level % 2 == 0)
+	{
+	  if (this_type == FRIBIDI_TYPE_R)
+	    RL_LEVEL(pp) = level + 1;
+	  else if (this_type == FRIBIDI_TYPE_AN)
+	    RL_LEVEL(pp) = level + 2;
+	  else if (RL_TYPE(pp->prev) != FRIBIDI_TYPE_L && this_type == FRIBIDI_TYPE_EN)
+	    RL_LEVEL(pp) = level + 2;
+	  else
+	    RL_LEVEL(pp) = level;
+	}
+      /* Odd */
+      else
+	{
+	  if (   this_type == FRIBIDI_TYPE_L
+	      || this_type == FRIBIDI_TYPE_AN
+	      || this_type == FRIBIDI_TYPE_EN)
+	    RL_LEVEL(pp) = level+1;
+	  else
+	    RL_LEVEL(pp) = level;
+	}
     }
-#endif
-  
-  *ptype_rl_list = type_rl_list;
-  *pmax_level = max_level;
-  *pbase_dir = base_dir;
+
+  compact_list(ctx, sot);
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_LEVELS);
 }
 
 /*======================================================================
-//  Here starts the exposed front end functions.
+//  resolve_explicit_levels() applies the rules X1 to X9 to the run
+//  length list. The embedding levels are kept on a stack of fixed
+//  depth on the C stack, so no memory is allocated. A run of explicit
+//  codes is processed one code at a time, and the run is then turned
+//  into a boundary neutral at the level it was found in. Runs that are
+//  in the scope of an override get the type of the override.
 //----------------------------------------------------------------------*/
+#define MAX_EXPLICIT_LEVEL 61
 
-/*======================================================================
-//  fribidi_log2vis() calls the function_analyse_string() and then
-//  does reordering and fills in the output strings.
-//----------------------------------------------------------------------*/
-void fribidi_log2vis(/* input */
-		     FriBidiChar *str,
-		     gint len,
-		     FriBidiCharType *pbase_dir,
-		     /* output */
-		     FriBidiChar *visual_str,
-		     guint16     *position_L_to_V_list,
-		     guint16     *position_V_to_L_list,
-		     guint8      *embedding_level_list
-		     )
+static void
+resolve_explicit_levels(TypeLink *type_rl_list,
+			gint base_level)
 {
-  TypeLink *type_rl_list, *pp = NULL;
-  gint max_level;
-  gboolean private_V_to_L = FALSE;
+  struct {
+    guint8 level;
+    guint8 override;
+  } stack[MAX_EXPLICIT_LEVEL];
+  gint stack_size = 0;
+  gint overflow = 0;
+  gint level = base_level;
+  FriBidiCharType override = FRIBIDI_TYPE_ON;
+  TypeLink *pp;
 
-  if (len == 0)
-    return;
-  
-  /* If l2v is to be calculated we must have l2v as well. If it is not
-     given by the caller, we have to make a private instance of it. */
-  if (position_L_to_V_list && !position_V_to_L_list)
+  for (pp = type_rl_list->next; pp->next; pp = pp->next)
     {
-      private_V_to_L = TRUE;
-      position_V_to_L_list = g_new(guint16, len+1);
-    }
+      gint this_type = RL_TYPE(pp);
+      gint i;
 
-  if (len > FRIBIDI_MAX_STRING_LENGTH)
-    {
-#ifndef NO_STDIO
-	fprintf(stderr, "Fribidi can't handle strings > 65000 chars!\n");
-#endif
-      return;
-    }
-  fribidi_analyse_string(str, len, pbase_dir,
-			 /* output */
-			 &type_rl_list,
-			 &max_level);
+      RL_LEVEL(pp) = level;
 
-  /* 7. Reordering resolved levels */
-  DBG("Reordering.\n");
+      /* X2 to X5. Explicit embeddings and overrides */
+      if (   this_type == FRIBIDI_TYPE_LRE
+	  || this_type == FRIBIDI_TYPE_RLE
+	  || this_type == FRIBIDI_TYPE_LRO
+	  || this_type == FRIBIDI_TYPE_RLO)
+	{
+	  for (i=0; i<RL_LEN(pp); i++)
+	    {
+	      gint new_level;
 
-  {
-    gint level_idx;
-    gint i;
+	      if (   this_type == FRIBIDI_TYPE_RLE
+		  || this_type == FRIBIDI_TYPE_RLO)
+		new_level = (level + 1) | 1;         /* Next odd level */
+	      else
+		new_level = (level + 2) & ~1;        /* Next even level */
 
-    /* Set up the ordering array to sorted order and copy the logical
-       string to the visual */
-    if (position_L_to_V_list)
-      for (i=0; i<len+1; i++)
-	position_L_to_V_list[i]=i;
-    
-    if (visual_str)
-      for (i=0; i<len+1; i++)
-	visual_str[i] = str[i];
+	      if (new_level > MAX_EXPLICIT_LEVEL)
+		{
+		  overflow++;
+		  continue;
+		}
 
-    /* Assign the embedding level array */
-    if (embedding_level_list)
-      for (pp = type_rl_list->next; pp->next; pp = pp->next)
-	{
-	  gint i;
-	  gint pos = RL_POS(pp);
-	  gint len = RL_LEN(pp);
-	  gint level = RL_LEVEL(pp);
-	  for (i=0; i<len; i++)
-	    embedding_level_list[pos + i] = level;
-      }
-    
-    /* Reorder both the outstring and the order array*/
-    if (visual_str || position_V_to_L_list)
-      {
+	      stack[stack_size].level = level;
+	      stack[stack_size].override = override;
+	      stack_size++;
+
+	      level = new_level;
+	      if (this_type == FRIBIDI_TYPE_LRO)
+		override = FRIBIDI_TYPE_L;
+	      else if (this_type == FRIBIDI_TYPE_RLO)
+		override = FRIBIDI_TYPE_R;
+	      else
+		override = FRIBIDI_TYPE_ON;
+	    }
+	  RL_TYPE(pp) = FRIBIDI_TYPE_BN;
+	}
 
-	if (visual_str)
-	  /* Mirror all characters that are in odd levels and have mirrors */
-	  for (pp = type_rl_list->next; pp->next; pp = pp->next)
+      /* X7. Terminating embeddings and overrides */
+      else if (this_type == FRIBIDI_TYPE_PDF)
+	{
+	  for (i=0; i<RL_LEN(pp); i++)
 	    {
-	      if (RL_LEVEL(pp) % 2 == 1)
+	      if (overflow > 0)
+		overflow--;
+	      else if (stack_size > 0)
 		{
-		  gint i;
-		  for (i=RL_POS(pp); i<RL_POS(pp)+RL_LEN(pp); i++)
-		    {
-		      FriBidiChar mirrored_ch;
-		      if (fribidi_get_mirror_char(visual_str[i], &mirrored_ch))
-			visual_str[i] = mirrored_ch;
-		    }
+		  stack_size--;
+		  level = stack[stack_size].level;
+		  override = stack[stack_size].override;
 		}
 	    }
+	  RL_TYPE(pp) = FRIBIDI_TYPE_BN;
+	}
 
-	/* Reorder */
-	for (level_idx = max_level; level_idx>0; level_idx--)
-	  {
-	    for (pp = type_rl_list->next; pp->next; pp = pp->next)
-	      {
-		if (RL_LEVEL(pp) >= level_idx)
-		  {
-		    /* Find all stretches that are >= level_idx */
-		    gint len = RL_LEN(pp);
-		    gint pos = RL_POS(pp);
-                    TypeLink *pp1 = pp->next;
-		    while(pp1->next && RL_LEVEL(pp1) >= level_idx)
-		      {
-			len+= RL_LEN(pp1);
-			pp1 = pp1->next;
-		      }
-		    
-		    pp = pp1->prev;
-		    if (visual_str)
-		      bidi_string_reverse(visual_str+pos, len);
-		    if (position_V_to_L_list)
-		      int16_array_reverse(position_V_to_L_list+pos, len);
-
-		  }
-	      }
-	  }
-      }
-
-    /* Convert the l2v list to v2l */
-    if (position_V_to_L_list && position_L_to_V_list)
-      for (i=0; i<len; i++)
-	position_V_to_L_list[position_L_to_V_list[i]] = i;
-  }
-
-  /* Free up the rl_list */
-
-  /* At this point, pp points to the last link or (rarely) might be NULL
-   */
-  if (!pp)
-    for (pp = type_rl_list->next; pp->next; pp = pp->next)
-      /* Nothing */;
-  
-  pp->next = free_type_links;
-  free_type_links = type_rl_list;
+      /* X8. All embeddings are terminated at the end of a paragraph */
+      else if (this_type == FRIBIDI_TYPE_BS)
+	{
+	  RL_LEVEL(pp) = base_level;
+	  level = base_level;
+	  override = FRIBIDI_TYPE_ON;
+	  stack_size = 0;
+	  overflow = 0;
+	}
 
-  /* Free up V_to_L if we allocated it */
-  if (private_V_to_L)
-    g_free(position_V_to_L_list);
-  
+      /* X6. Everything else gets the current level and override */
+      else if (override != FRIBIDI_TYPE_ON)
+	RL_TYPE(pp) = override;
+    }
+}
+
+/*======================================================================
+//  resolve_level_runs() splits the list into level runs and resolves
+//  each of them between two sentinel links on the stack that carry
+//  the sor and the eor of the run.
+//----------------------------------------------------------------------*/
+static void
+resolve_level_runs(FriBidiContext *ctx,
+		   TypeLink *type_rl_list,
+		   gint base_level)
+{
+  TypeLink *first = type_rl_list->next;
+  gint prev_level = base_level;
+
+  while (first->next)
+    {
+      TypeLink sot, eot;
+      TypeLink *before = first->prev;
+      TypeLink *last = first;
+      TypeLink *after;
+      gint level = RL_LEVEL(first);
+      gint next_level;
+
+      while (last->next->next && RL_LEVEL(last->next) == level)
+	last = last->next;
+      after = last->next;
+      next_level = after->next ? RL_LEVEL(after) : base_level;
+
+      /* X10. sor and eor are given by the higher of the two levels */
+      sot.type = (MAX(prev_level, level) % 2) ? FRIBIDI_TYPE_R : FRIBIDI_TYPE_L;
+      eot.type = (MAX(next_level, level) % 2) ? FRIBIDI_TYPE_R : FRIBIDI_TYPE_L;
+      sot.level = eot.level = -1;
+      sot.pos = RL_POS(first);
+      eot.pos = RL_POS(after);
+      sot.len = eot.len = 0;
+      sot.prev = NULL;
+      sot.next = first;
+      first->prev = &sot;
+      eot.next = NULL;
+      eot.prev = last;
+      last->next = &eot;
+
+      resolve_level_run(ctx, &sot, level, sot.type);
+
+      /* Link the resolved run back into the list */
+      before->next = sot.next;
+      sot.next->prev = before;
+      after->prev = eot.prev;
+      eot.prev->next = after;
+
+      prev_level = level;
+      first = after;
+    }
+}
+
+/* The explicit codes are classified next to each other */
+#define IS_EXPLICIT_TYPE(type) \
+  ((type) >= FRIBIDI_TYPE_LRE && (type) <= FRIBIDI_TYPE_PDF)
+
+/*======================================================================
+//  This function should follow the Unicode specification closely!
+//
+//  fribidi_analyse_types() works on the classified characters, so
+//  that the text may be classified from any representation. The
+//  caller tells if there are explicit codes among the types. Text
+//  without explicit codes is resolved as a single level run at the
+//  base level, so it doesn't pay for the explicit rules.
+//----------------------------------------------------------------------*/
+static void
+fribidi_analyse_types(FriBidiContext *ctx,
+		      /* input */
+		      gint *char_type,
+		      gint len,
+		      gboolean has_explicit,
+		      FriBidiCharType *pbase_dir,
+		      /* output */
+		      TypeLink **ptype_rl_list,
+		      gint *pmax_level)
+{
+  gint base_level, base_dir;
+  gint max_level;
+  TypeLink *type_rl_list, *pp;
+  STATS_TIMER(t)
+
+  STATS_ADD(ctx, calls, 1);
+  STATS_ADD(ctx, chars, len);
+
+  /* Run length encode the character types */
+  type_rl_list = run_length_encode_types(ctx, char_type, len);
+
+  /* Find the base level */
+  if (*pbase_dir == FRIBIDI_TYPE_L)
+    {
+      base_dir = FRIBIDI_TYPE_L;
+      base_level = 0;
+    }
+  else if (*pbase_dir == FRIBIDI_TYPE_R)
+    {
+      base_dir = FRIBIDI_TYPE_R;
+      base_level = 1;
+    }
+
+  /* Search for first strong character and use its direction as base
+     direciton */
+  else
+    {
+      base_level = 0; /* Default */
+      base_dir = FRIBIDI_TYPE_N;
+      for (pp = type_rl_list; pp; pp = pp->next)
+	{
+	  if (RL_TYPE(pp) == FRIBIDI_TYPE_R)
+	    {
+	      base_level = 1;
+	      base_dir = FRIBIDI_TYPE_R;
+	      break;
+	    }
+	  else if (RL_TYPE(pp) == FRIBIDI_TYPE_L)
+	    {
+	      base_level = 0;
+	      base_dir = FRIBIDI_TYPE_L;
+	      break;
+	    }
+	}
+    
+      /* If no strong base_dir was found, resort to the weak direction
+       * that was passed on input.
+       */
+      if (base_dir == FRIBIDI_TYPE_N)
+	{
+	  if (*pbase_dir == FRIBIDI_TYPE_WR)
+	    {
+	      base_dir = FRIBIDI_TYPE_RTL;
+	      base_level = 1;
+	    }
+	  else if (*pbase_dir == FRIBIDI_TYPE_WL)
+	    {
+	      base_dir = FRIBIDI_TYPE_LTR;
+	      base_level = 0;
+	    }
+	}
+    }
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_CLASSIFY);
+  
+  /* 1. to 3. Explicit levels, overrides and terminating embeddings */
+  if (has_explicit)
+    {
+      TRACE_PHASE(FRIBIDI_PHASE_EXPLICIT);
+      resolve_explicit_levels(type_rl_list, base_level);
+      compact_list(ctx, type_rl_list);
+      TRACE(trace_runs(FRIBIDI_TRACE_TYPES, type_rl_list));
+      STATS_LAP(ctx, t, FRIBIDI_PHASE_EXPLICIT);
+      resolve_level_runs(ctx, type_rl_list, base_level);
+    }
+  else
+    {
+      for (pp = type_rl_list->next; pp->next; pp = pp->next)
+	RL_LEVEL(pp) = base_level;
+      resolve_level_run(ctx, type_rl_list, base_level, base_dir);
+    }
+  STATS_RESTART(t);
+
+  compact_list(ctx, type_rl_list);
+
+  max_level = base_level;
+  for (pp = type_rl_list->next; pp->next; pp = pp->next)
+    if (RL_LEVEL(pp) > max_level)
+      max_level = RL_LEVEL(pp);
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_LEVELS);
+
+  TRACE(trace_runs(FRIBIDI_TRACE_RESOLVED, type_rl_list));
+  
+  *ptype_rl_list = type_rl_list;
+  *pmax_level = max_level;
+  *pbase_dir = base_dir;
+}
+
+static void
+fribidi_analyse_string(FriBidiContext *ctx,
+		       /* input */
+		       FriBidiChar *str,
+		       gint len,
+		       FriBidiCharType *pbase_dir,
+		       /* output */
+                       TypeLink **ptype_rl_list,
+		       gint *pmax_level)
+{
+  gint i;
+  gint *char_type;
+  gboolean has_explicit = FALSE;
+  STATS_TIMER(t)
+
+  TRACE(trace_string(str, len, *pbase_dir));
+  TRACE_PHASE(FRIBIDI_PHASE_CLASSIFY);
+
+  /* Determinate character types */
+  char_type = fribidi_context_alloc(ctx, sizeof(gint) * len);
+  for (i=0; i<len; i++)
+    {
+      char_type[i] = fribidi_get_type(str[i]);
+      if (IS_EXPLICIT_TYPE(char_type[i]))
+	has_explicit = TRUE;
+    }
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_CLASSIFY);
+
+  fribidi_analyse_types(ctx, char_type, len, has_explicit, pbase_dir,
+			/* output */
+			ptype_rl_list,
+			pmax_level);
+  fribidi_context_free(ctx, char_type, sizeof(gint) * len);
+}
+
+/*======================================================================
+//  find_visual_run_order() applies rule L2 to the runs instead of to
+//  the characters. It returns the runs in logical order in *pruns and
+//  the logical indices of the runs in visual order in *porder.
+//----------------------------------------------------------------------*/
+static gint
+find_visual_run_order(FriBidiContext *ctx,
+		      TypeLink *type_rl_list,
+		      gint max_level,
+		      /* output */
+		      TypeLink ***pruns,
+		      guint16 **porder)
+{
+  TypeLink *pp;
+  TypeLink **runs;
+  guint16 *order;
+  gint num_runs = 0;
+  gint level_idx, i;
+
+  for (pp = type_rl_list->next; pp->next; pp = pp->next)
+    num_runs++;
+
+  runs = fribidi_context_alloc(ctx, sizeof(TypeLink*) * num_runs);
+  order = fribidi_context_alloc(ctx, sizeof(guint16) * num_runs);
+
+  for (pp = type_rl_list->next, i = 0; pp->next; pp = pp->next, i++)
+    {
+      runs[i] = pp;
+      order[i] = i;
+    }
+
+  for (level_idx = max_level; level_idx>0; level_idx--)
+    for (i=0; i<num_runs; i++)
+      if (RL_LEVEL(runs[order[i]]) >= level_idx)
+	{
+	  /* Find all stretches that are >= level_idx */
+	  gint j = i+1;
+	  while (j<num_runs && RL_LEVEL(runs[order[j]]) >= level_idx)
+	    j++;
+	  int16_array_reverse(order+i, j-i);
+	  STATS_ADD(ctx, reversals, 1);
+	  STATS_ADD(ctx, reversed_runs, j-i);
+	  i = j;
+	}
+
+  *pruns = runs;
+  *porder = order;
+  return num_runs;
+}
+
+/*======================================================================
+//  fill_position_maps() writes the position maps from the visual order
+//  of the runs. A run at an odd level is written as a descending ramp.
+//----------------------------------------------------------------------*/
+static void
+fill_position_maps(TypeLink **runs,
+		   guint16 *order,
+		   gint num_runs,
+		   /* output */
+		   guint16 *position_L_to_V_list,
+		   guint16 *position_V_to_L_list)
+{
+  gint i, vis_pos = 0;
+
+  for (i=0; i<num_runs; i++)
+    {
+      TypeLink *run = runs[order[i]];
+      gint pos = RL_POS(run);
+      gint len = RL_LEN(run);
+
+      if (RL_LEVEL(run) % 2 == 1)
+	{
+	  if (position_V_to_L_list)
+	    fill_index_ramp(position_V_to_L_list + vis_pos, len, pos+len-1, -1);
+	  if (position_L_to_V_list)
+	    fill_index_ramp(position_L_to_V_list + pos, len, vis_pos+len-1, -1);
+	}
+      else
+	{
+	  if (position_V_to_L_list)
+	    fill_index_ramp(position_V_to_L_list + vis_pos, len, pos, 1);
+	  if (position_L_to_V_list)
+	    fill_index_ramp(position_L_to_V_list + pos, len, vis_pos, 1);
+	}
+      vis_pos += len;
+    }
+}
+
+/*======================================================================
+//  write_levels_and_maps() writes the embedding levels and the
+//  position maps of the resolved list, each of them if it is given.
+//  The position maps are written directly from the visual order of
+//  the runs.
+//----------------------------------------------------------------------*/
+static void
+write_levels_and_maps(FriBidiContext *ctx,
+		      TypeLink *type_rl_list,
+		      gint max_level,
+		      /* output */
+		      guint16 *position_L_to_V_list,
+		      guint16 *position_V_to_L_list,
+		      guint8 *embedding_level_list)
+{
+  TypeLink *pp;
+  STATS_TIMER(t)
+
+  if (embedding_level_list)
+    for (pp = type_rl_list->next; pp->next; pp = pp->next)
+      {
+	gint i;
+	gint pos = RL_POS(pp);
+	gint len = RL_LEN(pp);
+	gint level = RL_LEVEL(pp);
+	for (i=0; i<len; i++)
+	  embedding_level_list[pos + i] = level;
+      }
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_LEVELS);
+
+  if (position_L_to_V_list || position_V_to_L_list)
+    {
+      TypeLink **runs;
+      guint16 *order;
+      gint num_runs;
+
+      num_runs = find_visual_run_order(ctx, type_rl_list, max_level,
+				       &runs, &order);
+      fill_position_maps(runs, order, num_runs,
+			 position_L_to_V_list,
+			 position_V_to_L_list);
+      fribidi_context_free(ctx, order, sizeof(guint16) * num_runs);
+      fribidi_context_free(ctx, runs, sizeof(TypeLink*) * num_runs);
+    }
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_REORDER);
+}
+
+/*======================================================================
+//  write_level_runs() writes the levels of the resolved list as runs
+//  of characters with the same level, in logical order. Neighbouring
+//  links that differ in type only are merged. At most max_runs runs
+//  are written, but the number of runs is returned even if it is
+//  larger.
+//----------------------------------------------------------------------*/
+static gint
+write_level_runs(TypeLink *type_rl_list,
+		 /* output */
+		 FriBidiLevelRun *level_runs,
+		 gint max_runs)
+{
+  TypeLink *pp;
+  gint num_runs = 0;
+  gint run_level = -1;
+
+  for (pp = type_rl_list->next; pp->next; pp = pp->next)
+    {
+      if (RL_LEVEL(pp) == run_level)
+	{
+	  if (num_runs <= max_runs)
+	    level_runs[num_runs-1].length += RL_LEN(pp);
+	  continue;
+	}
+
+      run_level = RL_LEVEL(pp);
+      if (num_runs < max_runs)
+	{
+	  level_runs[num_runs].start = RL_POS(pp);
+	  level_runs[num_runs].length = RL_LEN(pp);
+	  level_runs[num_runs].level = run_level;
+	}
+      num_runs++;
+    }
+
+  return num_runs;
+}
+
+/*======================================================================
+//  write_rtl_mask() writes one bit per character, set for the
+//  characters with an odd level. Character i is bit i % 64 of
+//  rtl_mask[i / 64], and rtl_mask must hold (len + 63) / 64 words.
+//  The unused bits of the last word are cleared.
+//----------------------------------------------------------------------*/
+static void
+set_bit_range(guint64 *mask, gint start, gint len)
+{
+  gint end = start + len;
+
+  while (start < end)
+    {
+      gint bit = start % 64;
+      gint n = MIN(64 - bit, end - start);
+      guint64 bits = (n == 64) ? ~(guint64)0 : (((guint64)1 << n) - 1) << bit;
+
+      mask[start / 64] |= bits;
+      start += n;
+    }
+}
+
+static void
+write_rtl_mask(TypeLink *type_rl_list,
+	       gint len,
+	       /* output */
+	       guint64 *rtl_mask)
+{
+  TypeLink *pp;
+  gint i;
+
+  for (i=0; i<(len + 63) / 64; i++)
+    rtl_mask[i] = 0;
+
+  for (pp = type_rl_list->next; pp->next; pp = pp->next)
+    if (RL_LEVEL(pp) % 2 == 1)
+      set_bit_range(rtl_mask, RL_POS(pp), RL_LEN(pp));
+}
+
+/*======================================================================
+//  Here starts the exposed front end functions.
+//----------------------------------------------------------------------*/
+
+/*======================================================================
+//  log2vis() calls the function_analyse_string() and then does
+//  reordering and fills in the output strings, and the level runs and
+//  the rtl mask if they are given, all from the one analysis. All scratch memory
+//  is taken from the allocator of ctx. If visual_str is the same
+//  buffer as str, the string is mirrored and reordered in place.
+//  Returns the number of level runs, or 0 if level_runs is NULL.
+//----------------------------------------------------------------------*/
+static gint
+log2vis(FriBidiContext *ctx,
+	/* input */
+	FriBidiChar *str,
+	gint len,
+	FriBidiCharType *pbase_dir,
+	/* output */
+	FriBidiChar *visual_str,
+	guint16     *position_L_to_V_list,
+	guint16     *position_V_to_L_list,
+	guint8      *embedding_level_list,
+	FriBidiLevelRun *level_runs,
+	gint max_runs,
+	guint64 *rtl_mask
+	)
+{
+  TypeLink *type_rl_list, *pp;
+  gint max_level;
+  gint num_runs = 0;
+  STATS_TIMER(t)
+
+  if (len == 0)
+    return 0;
+  
+  if (len > FRIBIDI_MAX_STRING_LENGTH)
+    {
+#ifndef NO_STDIO
+	fprintf(stderr, "Fribidi can't handle strings > 65000 chars!\n");
+#endif
+      return 0;
+    }
+
+  fribidi_analyse_string(ctx, str, len, pbase_dir,
+			 /* output */
+			 &type_rl_list,
+			 &max_level);
+  STATS_RESTART(t);
+
+  /* 7. Reordering resolved levels */
+  TRACE_PHASE(FRIBIDI_PHASE_REORDER);
+
+  {
+    gint level_idx;
+    gint i;
+
+    /* Copy the logical string to the visual, unless the reordering is
+       done in place. */
+    if (visual_str && visual_str != str)
+      for (i=0; i<len+1; i++)
+	visual_str[i] = str[i];
+    STATS_LAP(ctx, t, FRIBIDI_PHASE_REORDER);
+
+    write_levels_and_maps(ctx, type_rl_list, max_level,
+			  position_L_to_V_list,
+			  position_V_to_L_list,
+			  embedding_level_list);
+    STATS_RESTART(t);
+
+    /* Reorder the outstring */
+    if (visual_str)
+      {
+	/* Mirror all characters that are in odd levels and have mirrors */
+	for (pp = type_rl_list->next; pp->next; pp = pp->next)
+	  {
+	    if (RL_LEVEL(pp) % 2 == 1)
+	      {
+		gint i;
+		for (i=RL_POS(pp); i<RL_POS(pp)+RL_LEN(pp); i++)
+		  {
+		    FriBidiChar mirrored_ch;
+		    if (fribidi_get_mirror_char(visual_str[i], &mirrored_ch))
+		      visual_str[i] = mirrored_ch;
+		  }
+		STATS_ADD(ctx, mirror_lookups, RL_LEN(pp));
+	      }
+	  }
+	STATS_LAP(ctx, t, FRIBIDI_PHASE_MIRROR);
+
+	/* Reorder */
+	for (level_idx = max_level; level_idx>0; level_idx--)
+	  {
+	    for (pp = type_rl_list->next; pp->next; pp = pp->next)
+	      {
+		if (RL_LEVEL(pp) >= level_idx)
+		  {
+		    /* Find all stretches that are >= level_idx */
+		    gint len = RL_LEN(pp);
+		    gint pos = RL_POS(pp);
+                    TypeLink *pp1 = pp->next;
+		    while(pp1->next && RL_LEVEL(pp1) >= level_idx)
+		      {
+			len+= RL_LEN(pp1);
+			pp1 = pp1->next;
+		      }
+		    
+		    pp = pp1->prev;
+		    bidi_string_reverse(visual_str+pos, len);
+		    STATS_ADD(ctx, reversals, 1);
+		    STATS_ADD(ctx, reversed_chars, len);
+		  }
+	      }
+	  }
+	STATS_LAP(ctx, t, FRIBIDI_PHASE_REORDER);
+      }
+  }
+
+  if (level_runs)
+    num_runs = write_level_runs(type_rl_list, level_runs, max_runs);
+  if (rtl_mask)
+    write_rtl_mask(type_rl_list, len, rtl_mask);
+
+  /* Free up the rl_list */
+  fribidi_type_link_list_free(ctx, type_rl_list);
+
+  return num_runs;
+}
+
+void fribidi_context_log2vis(FriBidiContext *ctx,
+			     /* input */
+			     FriBidiChar *str,
+			     gint len,
+			     FriBidiCharType *pbase_dir,
+			     /* output */
+			     FriBidiChar *visual_str,
+			     guint16     *position_L_to_V_list,
+			     guint16     *position_V_to_L_list,
+			     guint8      *embedding_level_list
+			     )
+{
+  log2vis(ctx, str, len, pbase_dir,
+	  visual_str,
+	  position_L_to_V_list,
+	  position_V_to_L_list,
+	  embedding_level_list,
+	  NULL, 0, NULL);
+}
+
+void fribidi_log2vis(/* input */
+		     FriBidiChar *str,
+		     gint len,
+		     FriBidiCharType *pbase_dir,
+		     /* output */
+		     FriBidiChar *visual_str,
+		     guint16     *position_L_to_V_list,
+		     guint16     *position_V_to_L_list,
+		     guint8      *embedding_level_list
+		     )
+{
+  fribidi_context_log2vis(fribidi_default_context(),
+			  str, len, pbase_dir,
+			  visual_str,
+			  position_L_to_V_list,
+			  position_V_to_L_list,
+			  embedding_level_list);
+}
+
+/*======================================================================
+//  fribidi_log2vis_in_place() reorders str itself into visual order,
+//  saving the copy to a separate visual string. The position maps
+//  and the embedding levels are filled in if they are given.
+//----------------------------------------------------------------------*/
+void fribidi_context_log2vis_in_place(FriBidiContext *ctx,
+				      /* input and output */
+				      FriBidiChar *str,
+				      /* input */
+				      gint len,
+				      FriBidiCharType *pbase_dir,
+				      /* output */
+				      guint16 *position_L_to_V_list,
+				      guint16 *position_V_to_L_list,
+				      guint8  *embedding_level_list
+				      )
+{
+  fribidi_context_log2vis(ctx, str, len, pbase_dir,
+			  str,
+			  position_L_to_V_list,
+			  position_V_to_L_list,
+			  embedding_level_list);
+}
+
+void fribidi_log2vis_in_place(/* input and output */
+			      FriBidiChar *str,
+			      /* input */
+			      gint len,
+			      FriBidiCharType *pbase_dir,
+			      /* output */
+			      guint16 *position_L_to_V_list,
+			      guint16 *position_V_to_L_list,
+			      guint8  *embedding_level_list
+			      )
+{
+  fribidi_context_log2vis(fribidi_default_context(),
+			  str, len, pbase_dir,
+			  str,
+			  position_L_to_V_list,
+			  position_V_to_L_list,
+			  embedding_level_list);
 }
 
 /*======================================================================
 //  fribidi_embedding_levels() is used in order to just get the
 //  embedding levels.
 //----------------------------------------------------------------------*/
-void fribidi_log2vis_get_embedding_levels(
-                     /* input */
-		     FriBidiChar *str,
-		     gint len,
-		     FriBidiCharType *pbase_dir,
-		     /* output */
-		     guint8 *embedding_level_list
-		     )
+void fribidi_context_log2vis_get_embedding_levels(
+		     FriBidiContext *ctx,
+                     /* input */
+		     FriBidiChar *str,
+		     gint len,
+		     FriBidiCharType *pbase_dir,
+		     /* output */
+		     guint8 *embedding_level_list
+		     )
+{
+  TypeLink *type_rl_list;
+  gint max_level;
+
+  if (len == 0)
+    return;
+  
+  fribidi_analyse_string(ctx, str, len, pbase_dir,
+			 /* output */
+			 &type_rl_list,
+			 &max_level);
+
+  write_levels_and_maps(ctx, type_rl_list, max_level,
+			NULL, NULL, embedding_level_list);
+  
+  /* Free up the rl_list */
+  fribidi_type_link_list_free(ctx, type_rl_list);
+}
+
+void fribidi_log2vis_get_embedding_levels(
+                     /* input */
+		     FriBidiChar *str,
+		     gint len,
+		     FriBidiCharType *pbase_dir,
+		     /* output */
+		     guint8 *embedding_level_list
+		     )
+{
+  fribidi_context_log2vis_get_embedding_levels(fribidi_default_context(),
+					       str, len, pbase_dir,
+					       embedding_level_list);
+}
+
+
+/*======================================================================
+//  levels_to_run_list() builds a list of the runs of equal levels,
+//  between the same sentinel links as the list of the analysis, and
+//  returns the highest level in *pmax_level.
+//----------------------------------------------------------------------*/
+static TypeLink *levels_to_run_list(FriBidiContext *ctx,
+				    const guint8 *embedding_level_list,
+				    gint len,
+				    /* output */
+				    gint *pmax_level)
+{
+  TypeLink *list, *last, *link;
+  gint pos, max_level = 0;
+
+  list = fribidi_type_link_new(ctx);
+  list->type = FRIBIDI_TYPE_SOT;
+  list->level = -1;
+  last = list;
+
+  for (pos = 0; pos < len; pos += link->len)
+    {
+      gint level = embedding_level_list[pos];
+      gint end = pos + 1;
+
+      while (end < len && embedding_level_list[end] == level)
+	end++;
+
+      link = fribidi_type_link_new(ctx);
+      link->type = FRIBIDI_TYPE_N;
+      link->pos = pos;
+      link->len = end - pos;
+      link->level = level;
+      STATS_ADD(ctx, runs_created, 1);
+      last->next = link;
+      link->prev = last;
+      last = link;
+
+      if (level > max_level)
+	max_level = level;
+    }
+
+  link = fribidi_type_link_new(ctx);
+  link->type = FRIBIDI_TYPE_EOT;
+  link->pos = len;
+  link->level = -1;
+  last->next = link;
+  link->prev = last;
+
+  *pmax_level = max_level;
+  return list;
+}
+
+/*======================================================================
+//  fribidi_reorder_line() reorders one line of a paragraph from the
+//  embedding levels that the analysis of the whole paragraph gave, so
+//  that a paragraph that is broken into lines is only analysed once.
+//  The levels are used as they are given.
+//----------------------------------------------------------------------*/
+void fribidi_context_reorder_line(FriBidiContext *ctx,
+				  /* input */
+				  FriBidiChar *str,
+				  gint len,
+				  const guint8 *embedding_level_list,
+				  /* output */
+				  FriBidiChar *visual_str,
+				  guint16 *position_L_to_V_list,
+				  guint16 *position_V_to_L_list
+				  )
+{
+  TypeLink *run_list;
+  TypeLink **runs;
+  guint16 *order;
+  gint max_level, num_runs;
+  gint vis_pos, r, i;
+  STATS_TIMER(t)
+
+  if (len == 0)
+    return;
+
+  if (len > FRIBIDI_MAX_STRING_LENGTH)
+    {
+#ifndef NO_STDIO
+	fprintf(stderr, "Fribidi can't handle strings > 65000 chars!\n");
+#endif
+      return;
+    }
+
+  run_list = levels_to_run_list(ctx, embedding_level_list, len, &max_level);
+  num_runs = find_visual_run_order(ctx, run_list, max_level, &runs, &order);
+
+  if (visual_str)
+    {
+      vis_pos = 0;
+      for (r=0; r<num_runs; r++)
+	{
+	  TypeLink *run = runs[order[r]];
+	  gint pos = RL_POS(run);
+	  gint n = RL_LEN(run);
+
+	  if (RL_LEVEL(run) % 2 == 0)
+	    memcpy(visual_str + vis_pos, str + pos, n * sizeof(FriBidiChar));
+	  else
+	    {
+	      for (i=0; i<n; i++)
+		{
+		  FriBidiChar ch = str[pos + n - 1 - i];
+
+		  fribidi_get_mirror_char(ch, &ch);
+		  visual_str[vis_pos + i] = ch;
+		}
+	      STATS_ADD(ctx, mirror_lookups, n);
+	    }
+	  vis_pos += n;
+	}
+    }
+
+  fill_position_maps(runs, order, num_runs,
+		     position_L_to_V_list,
+		     position_V_to_L_list);
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_REORDER);
+
+  fribidi_context_free(ctx, order, sizeof(guint16) * num_runs);
+  fribidi_context_free(ctx, runs, sizeof(TypeLink*) * num_runs);
+  fribidi_type_link_list_free(ctx, run_list);
+}
+
+void fribidi_reorder_line(/* input */
+			  FriBidiChar *str,
+			  gint len,
+			  const guint8 *embedding_level_list,
+			  /* output */
+			  FriBidiChar *visual_str,
+			  guint16 *position_L_to_V_list,
+			  guint16 *position_V_to_L_list
+			  )
+{
+  fribidi_context_reorder_line(fribidi_default_context(),
+			       str, len, embedding_level_list,
+			       visual_str,
+			       position_L_to_V_list,
+			       position_V_to_L_list);
+}
+
+/*======================================================================
+//  fribidi_log2vis_get_level_runs() gives the embedding levels as runs
+//  of characters with the same level, in logical order. At most
+//  max_runs runs are written to level_runs. The number of runs is
+//  returned even if it is larger than max_runs, so that the caller
+//  can call again with a buffer large enough.
+//----------------------------------------------------------------------*/
+gint fribidi_context_log2vis_get_level_runs(
+		     FriBidiContext *ctx,
+                     /* input */
+		     FriBidiChar *str,
+		     gint len,
+		     FriBidiCharType *pbase_dir,
+		     /* output */
+		     FriBidiLevelRun *level_runs,
+		     gint max_runs
+		     )
+{
+  TypeLink *type_rl_list;
+  gint max_level;
+  gint num_runs;
+
+  if (len == 0)
+    return 0;
+  
+  fribidi_analyse_string(ctx, str, len, pbase_dir,
+			 /* output */
+			 &type_rl_list,
+			 &max_level);
+
+  num_runs = write_level_runs(type_rl_list, level_runs, max_runs);
+  
+  /* Free up the rl_list */
+  fribidi_type_link_list_free(ctx, type_rl_list);
+
+  return num_runs;
+}
+
+gint fribidi_log2vis_get_level_runs(
+                     /* input */
+		     FriBidiChar *str,
+		     gint len,
+		     FriBidiCharType *pbase_dir,
+		     /* output */
+		     FriBidiLevelRun *level_runs,
+		     gint max_runs
+		     )
+{
+  return fribidi_context_log2vis_get_level_runs(fribidi_default_context(),
+						str, len, pbase_dir,
+						level_runs, max_runs);
+}
+
+/*======================================================================
+//  fribidi_log2vis_level_runs() is fribidi_log2vis() that also gives
+//  the level runs of fribidi_log2vis_get_level_runs(), from the same
+//  analysis. Returns the number of runs, as that does.
+//----------------------------------------------------------------------*/
+gint fribidi_context_log2vis_level_runs(FriBidiContext *ctx,
+					/* input */
+					FriBidiChar *str,
+					gint len,
+					FriBidiCharType *pbase_dir,
+					/* output */
+					FriBidiChar *visual_str,
+					guint16 *position_L_to_V_list,
+					guint16 *position_V_to_L_list,
+					guint8  *embedding_level_list,
+					FriBidiLevelRun *level_runs,
+					gint max_runs
+					)
+{
+  return log2vis(ctx, str, len, pbase_dir,
+		 visual_str,
+		 position_L_to_V_list,
+		 position_V_to_L_list,
+		 embedding_level_list,
+		 level_runs, max_runs, NULL);
+}
+
+gint fribidi_log2vis_level_runs(/* input */
+				FriBidiChar *str,
+				gint len,
+				FriBidiCharType *pbase_dir,
+				/* output */
+				FriBidiChar *visual_str,
+				guint16 *position_L_to_V_list,
+				guint16 *position_V_to_L_list,
+				guint8  *embedding_level_list,
+				FriBidiLevelRun *level_runs,
+				gint max_runs
+				)
+{
+  return log2vis(fribidi_default_context(),
+		 str, len, pbase_dir,
+		 visual_str,
+		 position_L_to_V_list,
+		 position_V_to_L_list,
+		 embedding_level_list,
+		 level_runs, max_runs, NULL);
+}
+
+/*======================================================================
+//  fribidi_log2vis_get_rtl_mask() gives the mask of write_rtl_mask().
+//----------------------------------------------------------------------*/
+void fribidi_context_log2vis_get_rtl_mask(
+		     FriBidiContext *ctx,
+                     /* input */
+		     FriBidiChar *str,
+		     gint len,
+		     FriBidiCharType *pbase_dir,
+		     /* output */
+		     guint64 *rtl_mask
+		     )
+{
+  TypeLink *type_rl_list;
+  gint max_level;
+
+  if (len == 0)
+    return;
+  
+  fribidi_analyse_string(ctx, str, len, pbase_dir,
+			 /* output */
+			 &type_rl_list,
+			 &max_level);
+
+  write_rtl_mask(type_rl_list, len, rtl_mask);
+  
+  /* Free up the rl_list */
+  fribidi_type_link_list_free(ctx, type_rl_list);
+}
+
+void fribidi_log2vis_get_rtl_mask(
+                     /* input */
+		     FriBidiChar *str,
+		     gint len,
+		     FriBidiCharType *pbase_dir,
+		     /* output */
+		     guint64 *rtl_mask
+		     )
+{
+  fribidi_context_log2vis_get_rtl_mask(fribidi_default_context(),
+				       str, len, pbase_dir,
+				       rtl_mask);
+}
+
+/*======================================================================
+//  fribidi_log2vis_rtl_mask() is fribidi_log2vis() that also gives the
+//  mask of fribidi_log2vis_get_rtl_mask(), from the same analysis.
+//----------------------------------------------------------------------*/
+void fribidi_context_log2vis_rtl_mask(FriBidiContext *ctx,
+				      /* input */
+				      FriBidiChar *str,
+				      gint len,
+				      FriBidiCharType *pbase_dir,
+				      /* output */
+				      FriBidiChar *visual_str,
+				      guint16 *position_L_to_V_list,
+				      guint16 *position_V_to_L_list,
+				      guint8  *embedding_level_list,
+				      guint64 *rtl_mask
+				      )
+{
+  log2vis(ctx, str, len, pbase_dir,
+	  visual_str,
+	  position_L_to_V_list,
+	  position_V_to_L_list,
+	  embedding_level_list,
+	  NULL, 0, rtl_mask);
+}
+
+void fribidi_log2vis_rtl_mask(/* input */
+			      FriBidiChar *str,
+			      gint len,
+			      FriBidiCharType *pbase_dir,
+			      /* output */
+			      FriBidiChar *visual_str,
+			      guint16 *position_L_to_V_list,
+			      guint16 *position_V_to_L_list,
+			      guint8  *embedding_level_list,
+			      guint64 *rtl_mask
+			      )
+{
+  log2vis(fribidi_default_context(),
+	  str, len, pbase_dir,
+	  visual_str,
+	  position_L_to_V_list,
+	  position_V_to_L_list,
+	  embedding_level_list,
+	  NULL, 0, rtl_mask);
+}
+
+/*======================================================================
+//  The visual iterator. The paragraph is analysed once and the runs
+//  are put in visual order, but neither the visual string nor the
+//  position maps are written. Links that differ in type only are
+//  merged first, so the iterator sees each visual run once.
+//----------------------------------------------------------------------*/
+static void
+merge_level_runs(FriBidiContext *ctx,
+		 TypeLink *list)
+{
+  TypeLink *pp = list->next;
+
+  while (pp->next)
+    {
+      if (RL_LEVEL(pp->next) == RL_LEVEL(pp) && pp->next->next)
+	{
+	  TypeLink *next = pp->next;
+	  RL_LEN(pp) += RL_LEN(next);
+	  pp->next = next->next;
+	  next->next->prev = pp;
+	  fribidi_type_link_free(ctx, next);
+	}
+      else
+	pp = pp->next;
+    }
+}
+
+void fribidi_context_visual_iter_init(FriBidiContext *ctx,
+				      FriBidiVisualIter *iter,
+				      /* input */
+				      FriBidiChar *str,
+				      gint len,
+				      FriBidiCharType *pbase_dir)
+{
+  TypeLink *type_rl_list;
+  TypeLink **runs;
+  gint max_level;
+
+  iter->ctx = ctx;
+  iter->str = str;
+  iter->type_rl_list = NULL;
+  iter->runs = NULL;
+  iter->order = NULL;
+  iter->num_runs = 0;
+  iter->run_idx = 0;
+  iter->char_idx = 0;
+
+  if (len == 0 || len > FRIBIDI_MAX_STRING_LENGTH)
+    return;
+
+  fribidi_analyse_string(ctx, str, len, pbase_dir,
+			 /* output */
+			 &type_rl_list,
+			 &max_level);
+  merge_level_runs(ctx, type_rl_list);
+
+  iter->num_runs = find_visual_run_order(ctx, type_rl_list, max_level,
+					 &runs, &iter->order);
+  iter->type_rl_list = type_rl_list;
+  iter->runs = runs;
+}
+
+void fribidi_visual_iter_init(FriBidiVisualIter *iter,
+			      /* input */
+			      FriBidiChar *str,
+			      gint len,
+			      FriBidiCharType *pbase_dir)
+{
+  fribidi_context_visual_iter_init(fribidi_default_context(),
+				   iter, str, len, pbase_dir);
+}
+
+/*======================================================================
+//  fribidi_visual_iter_next_run() gives the next run in visual order
+//  by its logical start, its length and its level. The characters of
+//  a run at an odd level are displayed from the end of the run. The
+//  rest of a run that was partly read by next_char() is skipped.
+//----------------------------------------------------------------------*/
+gboolean fribidi_visual_iter_next_run(FriBidiVisualIter *iter,
+				      /* output */
+				      FriBidiLevelRun *run)
+{
+  TypeLink *pp;
+
+  if (iter->char_idx > 0)
+    {
+      iter->run_idx++;
+      iter->char_idx = 0;
+    }
+
+  if (iter->run_idx >= iter->num_runs)
+    return FALSE;
+
+  pp = ((TypeLink**)iter->runs)[iter->order[iter->run_idx++]];
+  run->start = RL_POS(pp);
+  run->length = RL_LEN(pp);
+  run->level = RL_LEVEL(pp);
+  return TRUE;
+}
+
+/*======================================================================
+//  fribidi_visual_iter_next_char() gives the next character in visual
+//  order, mirrored if it is in an odd level, and its logical position.
+//  log_pos may be NULL.
+//----------------------------------------------------------------------*/
+gboolean fribidi_visual_iter_next_char(FriBidiVisualIter *iter,
+				       /* output */
+				       FriBidiChar *ch,
+				       gint *log_pos)
+{
+  TypeLink *pp;
+  gint pos;
+
+  if (iter->run_idx >= iter->num_runs)
+    return FALSE;
+
+  pp = ((TypeLink**)iter->runs)[iter->order[iter->run_idx]];
+  if (RL_LEVEL(pp) % 2 == 1)
+    {
+      pos = RL_POS(pp) + RL_LEN(pp) - 1 - iter->char_idx;
+      STATS_ADD(iter->ctx, mirror_lookups, 1);
+      if (!fribidi_get_mirror_char(iter->str[pos], ch))
+	*ch = iter->str[pos];
+    }
+  else
+    {
+      pos = RL_POS(pp) + iter->char_idx;
+      *ch = iter->str[pos];
+    }
+
+  if (log_pos)
+    *log_pos = pos;
+
+  if (++iter->char_idx == RL_LEN(pp))
+    {
+      iter->run_idx++;
+      iter->char_idx = 0;
+    }
+  return TRUE;
+}
+
+/* Give the memory of the iterator back to its context */
+void fribidi_visual_iter_free(FriBidiVisualIter *iter)
+{
+  if (!iter->type_rl_list)
+    return;
+
+  fribidi_context_free(iter->ctx, iter->order,
+		       sizeof(guint16) * iter->num_runs);
+  fribidi_context_free(iter->ctx, iter->runs,
+		       sizeof(TypeLink*) * iter->num_runs);
+  fribidi_type_link_list_free(iter->ctx, iter->type_rl_list);
+  iter->type_rl_list = NULL;
+  iter->num_runs = 0;
+}
+
+/*======================================================================
+//  fribidi_log2vis_segments() analyses the text held in several
+//  segments as one paragraph, without gathering it into one string.
+//  The position maps and the levels use indices into the paragraph,
+//  which fribidi_segments_locate() turns into a segment and an offset.
+//----------------------------------------------------------------------*/
+void fribidi_context_log2vis_segments(FriBidiContext *ctx,
+				      /* input */
+				      FriBidiSegment *segments,
+				      gint num_segments,
+				      FriBidiCharType *pbase_dir,
+				      /* output */
+				      guint16 *position_L_to_V_list,
+				      guint16 *position_V_to_L_list,
+				      guint8  *embedding_level_list
+				      )
 {
-  TypeLink *type_rl_list, *pp;
+  TypeLink *type_rl_list;
   gint max_level;
+  gint *char_type;
+  gboolean has_explicit = FALSE;
+  gint len = 0;
+  gint seg, i, pos;
+  STATS_TIMER(t)
+
+  for (seg=0; seg<num_segments; seg++)
+    len += segments[seg].len;
 
-  if (len = 0)
+  if (len == 0)
     return;
   
-  fribidi_analyse_string(str, len, pbase_dir,
+  if (len > FRIBIDI_MAX_STRING_LENGTH)
+    {
+#ifndef NO_STDIO
+	fprintf(stderr, "Fribidi can't handle strings > 65000 chars!\n");
+#endif
+      return;
+    }
+
+  /* Classify the segments into one array of types */
+  char_type = fribidi_context_alloc(ctx, sizeof(gint) * len);
+  for (seg=0, pos=0; seg<num_segments; seg++)
+    for (i=0; i<segments[seg].len; i++, pos++)
+      {
+	char_type[pos] = fribidi_get_type(segments[seg].str[i]);
+	if (IS_EXPLICIT_TYPE(char_type[pos]))
+	  has_explicit = TRUE;
+      }
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_CLASSIFY);
+
+  fribidi_analyse_types(ctx, char_type, len, has_explicit, pbase_dir,
+			/* output */
+			&type_rl_list,
+			&max_level);
+  fribidi_context_free(ctx, char_type, sizeof(gint) * len);
+
+  write_levels_and_maps(ctx, type_rl_list, max_level,
+			position_L_to_V_list,
+			position_V_to_L_list,
+			embedding_level_list);
+
+  /* Free up the rl_list */
+  fribidi_type_link_list_free(ctx, type_rl_list);
+}
+
+void fribidi_log2vis_segments(/* input */
+			      FriBidiSegment *segments,
+			      gint num_segments,
+			      FriBidiCharType *pbase_dir,
+			      /* output */
+			      guint16 *position_L_to_V_list,
+			      guint16 *position_V_to_L_list,
+			      guint8  *embedding_level_list
+			      )
+{
+  fribidi_context_log2vis_segments(fribidi_default_context(),
+				   segments, num_segments, pbase_dir,
+				   position_L_to_V_list,
+				   position_V_to_L_list,
+				   embedding_level_list);
+}
+
+/*======================================================================
+//  UTF-8 decoding and encoding of single characters. A byte that
+//  doesn't start a well formed sequence, including overlong forms,
+//  surrogates and sequences cut by the end of the string, is taken
+//  as a character of its own, U+FFFD, and is copied through as is.
+//----------------------------------------------------------------------*/
+#define UTF8_REPLACEMENT_CHAR 0xFFFD
+
+static gint
+utf8_decode_char(gpointer str,
+		 gint len,
+		 /* output */
+		 FriBidiChar *ch)
+{
+  gint n = fribidi_utf8_decode_char(str, len, ch);
+
+  if (n == 0)
+    {
+      *ch = UTF8_REPLACEMENT_CHAR;
+      n = 1;
+    }
+  return n;
+}
+
+static void
+utf8_encode_char(FriBidiChar ch,
+		 gint n,
+		 /* output */
+		 gpointer str)
+{
+  guchar *s = str;
+
+  switch (n)
+    {
+    case 1:
+      s[0] = ch;
+      break;
+    case 2:
+      s[0] = 0xC0 | (ch >> 6);
+      s[1] = 0x80 | (ch & 0x3F);
+      break;
+    case 3:
+      s[0] = 0xE0 | (ch >> 12);
+      s[1] = 0x80 | ((ch >> 6) & 0x3F);
+      s[2] = 0x80 | (ch & 0x3F);
+      break;
+    default:
+      s[0] = 0xF0 | (ch >> 18);
+      s[1] = 0x80 | ((ch >> 12) & 0x3F);
+      s[2] = 0x80 | ((ch >> 6) & 0x3F);
+      s[3] = 0x80 | (ch & 0x3F);
+      break;
+    }
+}
+
+/*======================================================================
+//  UTF-16 decoding and encoding of single characters. A surrogate
+//  that isn't part of a pair is taken as U+FFFD and copied through.
+//----------------------------------------------------------------------*/
+#define UTF16_IS_HIGH(u) ((u) >= 0xD800 && (u) <= 0xDBFF)
+#define UTF16_IS_LOW(u) ((u) >= 0xDC00 && (u) <= 0xDFFF)
+
+static gint
+utf16_decode_char(gpointer str,
+		  gint len,
+		  /* output */
+		  FriBidiChar *ch)
+{
+  guint16 *s = str;
+
+  if (UTF16_IS_HIGH(s[0]) && len >= 2 && UTF16_IS_LOW(s[1]))
+    {
+      *ch = 0x10000 + ((s[0] - 0xD800) << 10) + (s[1] - 0xDC00);
+      return 2;
+    }
+  if (UTF16_IS_HIGH(s[0]) || UTF16_IS_LOW(s[0]))
+    *ch = UTF8_REPLACEMENT_CHAR;
+  else
+    *ch = s[0];
+  return 1;
+}
+
+static void
+utf16_encode_char(FriBidiChar ch,
+		  gint n,
+		  /* output */
+		  gpointer str)
+{
+  guint16 *s = str;
+
+  if (n == 1)
+    s[0] = ch;
+  else
+    {
+      s[0] = 0xD800 + ((ch - 0x10000) >> 10);
+      s[1] = 0xDC00 + ((ch - 0x10000) & 0x3FF);
+    }
+}
+
+/*======================================================================
+//  The code unit encodings that the algorithm can run on directly.
+//  decode() reads the character at the start of s, of which at most
+//  len units are left, and returns its length in units.
+//----------------------------------------------------------------------*/
+typedef struct {
+  gint unit_size;
+  gint (*decode) (gpointer s, gint len, FriBidiChar *ch);
+  void (*encode) (FriBidiChar ch, gint n, gpointer s);
+} UnitCodec;
+
+static const UnitCodec utf8_codec = {
+  sizeof(guchar), utf8_decode_char, utf8_encode_char
+};
+
+static const UnitCodec utf16_codec = {
+  sizeof(guint16), utf16_decode_char, utf16_encode_char
+};
+
+#define UNIT_PTR(codec, str, pos) ((guchar*)(str) + (pos) * (codec)->unit_size)
+
+/* Fill len entries of a gint map with start, start+step, ... */
+static void
+fill_int_ramp(gint *arr, gint len, gint start, gint step)
+{
+  gint i;
+
+  for (i=0; i<len; i++)
+    arr[i] = start + i * step;
+}
+
+/*======================================================================
+//  log2vis_encoded() runs the algorithm directly on text in a code
+//  unit encoding. The characters are classified as they are decoded.
+//  The list is only ever merged, so every run starts where the type
+//  of the characters changes, and the offset in units of each such
+//  change is kept to place the runs without decoding them again. The
+//  visual string is written from the visual order of the runs, one
+//  character at a time in the odd runs, which are decoded again to
+//  mirror them. No UCS-4 copy of the text is made.
+//
+//  The maps and the levels have one entry per code unit or one entry
+//  per character, as selected by units, and are indexed and valued in
+//  those units. In code units the units of a character keep their
+//  order, so the maps are permutations of the units. The visual
+//  string has the length of str, since the mirrored characters are
+//  encoded in as many units as the characters they replace.
+//
+//  The number of entries written to the maps and the levels is
+//  returned.
+//----------------------------------------------------------------------*/
+#define TYPE_CHANGES_CHUNK 64
+
+/* The type changes are pairs of a character position and the offset
+   of the character in units */
+static gint *
+add_type_change(FriBidiContext *ctx,
+		gint *changes,
+		gint *num_changes,
+		gint *max_changes,
+		gint char_pos,
+		gint unit_pos)
+{
+  if (*num_changes == *max_changes)
+    {
+      gint *more = fribidi_context_alloc(ctx, sizeof(gint) * 2
+					 * (*max_changes * 2 + TYPE_CHANGES_CHUNK));
+
+      if (changes)
+	{
+	  memcpy(more, changes, sizeof(gint) * 2 * *num_changes);
+	  fribidi_context_free(ctx, changes, sizeof(gint) * 2 * *max_changes);
+	}
+      changes = more;
+      *max_changes = *max_changes * 2 + TYPE_CHANGES_CHUNK;
+    }
+  changes[2 * *num_changes] = char_pos;
+  changes[2 * *num_changes + 1] = unit_pos;
+  (*num_changes)++;
+  return changes;
+}
+
+static gint
+log2vis_encoded(FriBidiContext *ctx,
+		const UnitCodec *codec,
+		/* input */
+		gpointer str,
+		gint len,
+		FriBidiCharType *pbase_dir,
+		FriBidiMapUnits units,
+		/* output */
+		gpointer visual_str,
+		gint *position_L_to_V_list,
+		gint *position_V_to_L_list,
+		guint8 *embedding_level_list)
+{
+  TypeLink *type_rl_list, *pp;
+  TypeLink **runs = NULL;
+  guint16 *order = NULL;
+  gint *char_type, *changes = NULL, *run_unit_pos = NULL;
+  gint num_changes = 0, max_changes = 0;
+  gint max_level, num_runs = 0, num_links = 0;
+  gint num_chars = 0;
+  gboolean has_explicit = FALSE;
+  gboolean reorder = visual_str || position_L_to_V_list || position_V_to_L_list;
+  gint unit_size = codec->unit_size;
+  gint vis_char, vis_unit;
+  gint i, r, k;
+  STATS_TIMER(t)
+
+  if (len == 0)
+    return 0;
+
+  /* Classify the characters as they are decoded, and keep where the
+     type changes, with len after the last character */
+  char_type = fribidi_context_alloc(ctx, sizeof(gint) * len);
+  for (i=0; i<len; )
+    {
+      FriBidiChar ch;
+      gint unit_pos = i;
+
+      i += codec->decode(UNIT_PTR(codec, str, i), len - i, &ch);
+      char_type[num_chars] = fribidi_get_type(ch);
+      if (IS_EXPLICIT_TYPE(char_type[num_chars]))
+	has_explicit = TRUE;
+      if (num_chars == 0 || char_type[num_chars] != char_type[num_chars - 1])
+	changes = add_type_change(ctx, changes, &num_changes, &max_changes,
+				  num_chars, unit_pos);
+      num_chars++;
+    }
+  changes = add_type_change(ctx, changes, &num_changes, &max_changes,
+			    num_chars, len);
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_CLASSIFY);
+
+  if (num_chars > FRIBIDI_MAX_STRING_LENGTH)
+    {
+#ifndef NO_STDIO
+	fprintf(stderr, "Fribidi can't handle strings > 65000 chars!\n");
+#endif
+      fribidi_context_free(ctx, char_type, sizeof(gint) * len);
+      fribidi_context_free(ctx, changes, sizeof(gint) * 2 * max_changes);
+      return 0;
+    }
+
+  fribidi_analyse_types(ctx, char_type, num_chars, has_explicit, pbase_dir,
+			/* output */
+			&type_rl_list,
+			&max_level);
+  fribidi_context_free(ctx, char_type, sizeof(gint) * len);
+  STATS_RESTART(t);
+
+  /* Find the offset in units of each run from the type changes, in
+     logical order, with len after the last run */
+  for (pp = type_rl_list->next; pp->next; pp = pp->next)
+    num_links++;
+  run_unit_pos = fribidi_context_alloc(ctx, sizeof(gint) * (num_links + 1));
+  for (pp = type_rl_list->next, r = 0, k = 0; pp->next; pp = pp->next, r++)
+    {
+      while (changes[2 * k] < RL_POS(pp))
+	k++;
+      run_unit_pos[r] = changes[2 * k + 1];
+    }
+  run_unit_pos[num_links] = len;
+  fribidi_context_free(ctx, changes, sizeof(gint) * 2 * max_changes);
+
+  if (embedding_level_list)
+    {
+      for (pp = type_rl_list->next, r = 0; pp->next; pp = pp->next, r++)
+	{
+	  if (units == FRIBIDI_MAP_CHARS)
+	    memset(embedding_level_list + RL_POS(pp), RL_LEVEL(pp), RL_LEN(pp));
+	  else
+	    memset(embedding_level_list + run_unit_pos[r], RL_LEVEL(pp),
+		   run_unit_pos[r + 1] - run_unit_pos[r]);
+	}
+    }
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_LEVELS);
+
+  if (!reorder)
+    {
+      fribidi_context_free(ctx, run_unit_pos, sizeof(gint) * (num_links + 1));
+      fribidi_type_link_list_free(ctx, type_rl_list);
+      return (units == FRIBIDI_MAP_CHARS) ? num_chars : len;
+    }
+
+  num_runs = find_visual_run_order(ctx, type_rl_list, max_level,
+				   &runs, &order);
+
+  vis_char = vis_unit = 0;
+  for (r=0; r<num_runs; r++)
+    {
+      TypeLink *run = runs[order[r]];
+      gint char_pos = RL_POS(run);
+      gint char_len = RL_LEN(run);
+      gint unit_pos = run_unit_pos[order[r]];
+      gint unit_len = run_unit_pos[order[r] + 1] - unit_pos;
+      gint pos = (units == FRIBIDI_MAP_CHARS) ? char_pos : unit_pos;
+      gint vis_pos = (units == FRIBIDI_MAP_CHARS) ? vis_char : vis_unit;
+      gint n = (units == FRIBIDI_MAP_CHARS) ? char_len : unit_len;
+
+      if (RL_LEVEL(run) % 2 == 0)
+	{
+	  if (visual_str)
+	    memcpy(UNIT_PTR(codec, visual_str, vis_unit),
+		   UNIT_PTR(codec, str, unit_pos), unit_len * unit_size);
+	  if (position_L_to_V_list)
+	    fill_int_ramp(position_L_to_V_list + pos, n, vis_pos, 1);
+	  if (position_V_to_L_list)
+	    fill_int_ramp(position_V_to_L_list + vis_pos, n, pos, 1);
+	}
+      else if (!visual_str && units == FRIBIDI_MAP_CHARS)
+	{
+	  /* The maps in characters need no decoding */
+	  if (position_L_to_V_list)
+	    fill_int_ramp(position_L_to_V_list + pos, n, vis_pos + n - 1, -1);
+	  if (position_V_to_L_list)
+	    fill_int_ramp(position_V_to_L_list + vis_pos, n, pos + n - 1, -1);
+	}
+      else
+	{
+	  /* Place each character of the run mirrored from its end */
+	  gint u = unit_pos, c = 0;
+
+	  while (u < unit_pos + unit_len)
+	    {
+	      FriBidiChar ch, mirrored_ch;
+	      gint ch_len = codec->decode(UNIT_PTR(codec, str, u), len - u, &ch);
+	      gint vu = vis_unit + unit_pos + unit_len - u - ch_len;
+	      gint vc = vis_char + char_len - 1 - c;
+
+	      if (visual_str)
+		{
+		  STATS_ADD(ctx, mirror_lookups, 1);
+		  if (fribidi_get_mirror_char(ch, &mirrored_ch))
+		    codec->encode(mirrored_ch, ch_len,
+				  UNIT_PTR(codec, visual_str, vu));
+		  else
+		    memcpy(UNIT_PTR(codec, visual_str, vu),
+			   UNIT_PTR(codec, str, u), ch_len * unit_size);
+		}
+
+	      if (units == FRIBIDI_MAP_CHARS)
+		{
+		  if (position_L_to_V_list)
+		    position_L_to_V_list[char_pos + c] = vc;
+		  if (position_V_to_L_list)
+		    position_V_to_L_list[vc] = char_pos + c;
+		}
+	      else
+		{
+		  if (position_L_to_V_list)
+		    fill_int_ramp(position_L_to_V_list + u, ch_len, vu, 1);
+		  if (position_V_to_L_list)
+		    fill_int_ramp(position_V_to_L_list + vu, ch_len, u, 1);
+		}
+
+	      u += ch_len;
+	      c++;
+	    }
+	}
+
+      vis_char += char_len;
+      vis_unit += unit_len;
+    }
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_REORDER);
+
+  fribidi_context_free(ctx, run_unit_pos, sizeof(gint) * (num_links + 1));
+  fribidi_context_free(ctx, order, sizeof(guint16) * num_runs);
+  fribidi_context_free(ctx, runs, sizeof(TypeLink*) * num_runs);
+  fribidi_type_link_list_free(ctx, type_rl_list);
+
+  return (units == FRIBIDI_MAP_CHARS) ? num_chars : len;
+}
+
+/*======================================================================
+//  fribidi_log2vis_utf8() runs the algorithm on UTF-8 text, with maps
+//  in bytes or in characters.
+//----------------------------------------------------------------------*/
+gint fribidi_context_log2vis_utf8(FriBidiContext *ctx,
+				  /* input */
+				  guchar *str,
+				  gint len,
+				  FriBidiCharType *pbase_dir,
+				  FriBidiMapUnits units,
+				  /* output */
+				  guchar *visual_str,
+				  gint *position_L_to_V_list,
+				  gint *position_V_to_L_list,
+				  guint8 *embedding_level_list
+				  )
+{
+  return log2vis_encoded(ctx, &utf8_codec, str, len, pbase_dir, units,
+			 visual_str,
+			 position_L_to_V_list,
+			 position_V_to_L_list,
+			 embedding_level_list);
+}
+
+gint fribidi_log2vis_utf8(/* input */
+			  guchar *str,
+			  gint len,
+			  FriBidiCharType *pbase_dir,
+			  FriBidiMapUnits units,
+			  /* output */
+			  guchar *visual_str,
+			  gint *position_L_to_V_list,
+			  gint *position_V_to_L_list,
+			  guint8 *embedding_level_list
+			  )
+{
+  return fribidi_context_log2vis_utf8(fribidi_default_context(),
+				      str, len, pbase_dir, units,
+				      visual_str,
+				      position_L_to_V_list,
+				      position_V_to_L_list,
+				      embedding_level_list);
+}
+
+/*======================================================================
+//  fribidi_log2vis_utf16() runs the algorithm on UTF-16 text, with
+//  maps in 16 bit units or in characters. Surrogate pairs are kept
+//  in order in the visual string.
+//----------------------------------------------------------------------*/
+gint fribidi_context_log2vis_utf16(FriBidiContext *ctx,
+				   /* input */
+				   guint16 *str,
+				   gint len,
+				   FriBidiCharType *pbase_dir,
+				   FriBidiMapUnits units,
+				   /* output */
+				   guint16 *visual_str,
+				   gint *position_L_to_V_list,
+				   gint *position_V_to_L_list,
+				   guint8 *embedding_level_list
+				   )
+{
+  return log2vis_encoded(ctx, &utf16_codec, str, len, pbase_dir, units,
+			 visual_str,
+			 position_L_to_V_list,
+			 position_V_to_L_list,
+			 embedding_level_list);
+}
+
+gint fribidi_log2vis_utf16(/* input */
+			   guint16 *str,
+			   gint len,
+			   FriBidiCharType *pbase_dir,
+			   FriBidiMapUnits units,
+			   /* output */
+			   guint16 *visual_str,
+			   gint *position_L_to_V_list,
+			   gint *position_V_to_L_list,
+			   guint8 *embedding_level_list
+			   )
+{
+  return fribidi_context_log2vis_utf16(fribidi_default_context(),
+				       str, len, pbase_dir, units,
+				       visual_str,
+				       position_L_to_V_list,
+				       position_V_to_L_list,
+				       embedding_level_list);
+}
+
+gint fribidi_context_log2vis_utf16_get_embedding_levels(
+				   FriBidiContext *ctx,
+				   /* input */
+				   guint16 *str,
+				   gint len,
+				   FriBidiCharType *pbase_dir,
+				   FriBidiMapUnits units,
+				   /* output */
+				   guint8 *embedding_level_list
+				   )
+{
+  return log2vis_encoded(ctx, &utf16_codec, str, len, pbase_dir, units,
+			 NULL, NULL, NULL,
+			 embedding_level_list);
+}
+
+gint fribidi_log2vis_utf16_get_embedding_levels(
+				   /* input */
+				   guint16 *str,
+				   gint len,
+				   FriBidiCharType *pbase_dir,
+				   FriBidiMapUnits units,
+				   /* output */
+				   guint8 *embedding_level_list
+				   )
+{
+  return fribidi_context_log2vis_utf16_get_embedding_levels(
+				   fribidi_default_context(),
+				   str, len, pbase_dir, units,
+				   embedding_level_list);
+}
+
+/*======================================================================
+//  fribidi_log2vis_8bit() runs the algorithm directly on text in an
+//  8-bit character set. type_table gives the bidi type of each byte,
+//  and mirror_table the byte that it is mirrored to, or itself. The
+//  bytes are classified through the table and the visual string is
+//  written from the visual order of the runs, so that no Unicode copy
+//  of the text is made, and the types can tell apart bytes that map
+//  to the same Unicode character.
+//----------------------------------------------------------------------*/
+void fribidi_context_log2vis_8bit(FriBidiContext *ctx,
+				  /* input */
+				  const FriBidiCharType *type_table,
+				  const guchar *mirror_table,
+				  guchar *str,
+				  gint len,
+				  FriBidiCharType *pbase_dir,
+				  /* output */
+				  guchar *visual_str,
+				  guint16 *position_L_to_V_list,
+				  guint16 *position_V_to_L_list,
+				  guint8 *embedding_level_list
+				  )
+{
+  TypeLink *type_rl_list, *pp;
+  TypeLink **runs;
+  guint16 *order;
+  gint *char_type;
+  gint max_level, num_runs;
+  gboolean has_explicit = FALSE;
+  gint vis_pos, i, r;
+  STATS_TIMER(t)
+
+  if (len == 0)
+    return;
+
+  if (len > FRIBIDI_MAX_STRING_LENGTH)
+    {
+#ifndef NO_STDIO
+	fprintf(stderr, "Fribidi can't handle strings > 65000 chars!\n");
+#endif
+      return;
+    }
+
+  char_type = fribidi_context_alloc(ctx, sizeof(gint) * len);
+  for (i=0; i<len; i++)
+    {
+      char_type[i] = type_table[str[i]];
+      if (IS_EXPLICIT_TYPE(char_type[i]))
+	has_explicit = TRUE;
+    }
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_CLASSIFY);
+
+  fribidi_analyse_types(ctx, char_type, len, has_explicit, pbase_dir,
+			/* output */
+			&type_rl_list,
+			&max_level);
+  fribidi_context_free(ctx, char_type, sizeof(gint) * len);
+  STATS_RESTART(t);
+
+  if (embedding_level_list)
+    for (pp = type_rl_list->next; pp->next; pp = pp->next)
+      memset(embedding_level_list + RL_POS(pp), RL_LEVEL(pp), RL_LEN(pp));
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_LEVELS);
+
+  if (!visual_str && !position_L_to_V_list && !position_V_to_L_list)
+    {
+      fribidi_type_link_list_free(ctx, type_rl_list);
+      return;
+    }
+
+  num_runs = find_visual_run_order(ctx, type_rl_list, max_level,
+				   &runs, &order);
+
+  if (visual_str)
+    {
+      vis_pos = 0;
+      for (r=0; r<num_runs; r++)
+	{
+	  TypeLink *run = runs[order[r]];
+	  gint pos = RL_POS(run);
+	  gint n = RL_LEN(run);
+
+	  if (RL_LEVEL(run) % 2 == 0)
+	    memcpy(visual_str + vis_pos, str + pos, n);
+	  else
+	    for (i=0; i<n; i++)
+	      visual_str[vis_pos + n - 1 - i] = mirror_table[str[pos + i]];
+	  vis_pos += n;
+	}
+    }
+  fill_position_maps(runs, order, num_runs,
+		     position_L_to_V_list, position_V_to_L_list);
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_REORDER);
+
+  fribidi_context_free(ctx, order, sizeof(guint16) * num_runs);
+  fribidi_context_free(ctx, runs, sizeof(TypeLink*) * num_runs);
+  fribidi_type_link_list_free(ctx, type_rl_list);
+}
+
+void fribidi_log2vis_8bit(/* input */
+			  const FriBidiCharType *type_table,
+			  const guchar *mirror_table,
+			  guchar *str,
+			  gint len,
+			  FriBidiCharType *pbase_dir,
+			  /* output */
+			  guchar *visual_str,
+			  guint16 *position_L_to_V_list,
+			  guint16 *position_V_to_L_list,
+			  guint8 *embedding_level_list
+			  )
+{
+  fribidi_context_log2vis_8bit(fribidi_default_context(),
+			       type_table, mirror_table,
+			       str, len, pbase_dir,
+			       visual_str,
+			       position_L_to_V_list,
+			       position_V_to_L_list,
+			       embedding_level_list);
+}
+
+/*======================================================================
+//  encode_chars() hands len characters to the encoder of char_set and
+//  returns FALSE if they did not all fit in size. *pout is advanced
+//  past the bytes, and *pdone by the characters written.
+//----------------------------------------------------------------------*/
+static gboolean encode_chars(const FriBidiCharSet *char_set,
+			     FriBidiChar *us,
+			     gint len,
+			     guchar **pout,
+			     gint size,
+			     gint *pdone)
+{
+  gint bytes, consumed;
+
+  bytes = char_set->encode(char_set, us, len, *pout, size, &consumed);
+  *pout += bytes;
+  *pdone += consumed;
+
+  return consumed == len;
+}
+
+/*======================================================================
+//  fribidi_log2vis_to_charset() writes the visual string directly in
+//  the character set of char_set while the runs are walked in visual
+//  order. The even runs are encoded from str as they are, and the odd
+//  runs are mirrored and reversed a block at a time on the stack, so
+//  that no Unicode copy of the visual string is made. Returns the
+//  number of bytes written; the output stops at the last character
+//  that fits in size, and *consumed, if given, is the number of
+//  visual characters written, which is less than len if the string
+//  was cut.
+//----------------------------------------------------------------------*/
+#define ENCODE_BLOCK_CHARS 64
+
+gint fribidi_context_log2vis_to_charset(FriBidiContext *ctx,
+					/* input */
+					FriBidiChar *str,
+					gint len,
+					FriBidiCharType *pbase_dir,
+					const FriBidiCharSet *char_set,
+					/* output */
+					guchar *visual_bytes,
+					gint size,
+					gint *consumed,
+					guint16 *position_L_to_V_list,
+					guint16 *position_V_to_L_list,
+					guint8  *embedding_level_list
+					)
+{
+  TypeLink *type_rl_list;
+  TypeLink **runs;
+  guint16 *order;
+  FriBidiChar block[ENCODE_BLOCK_CHARS];
+  guchar *out;
+  gint max_level, num_runs;
+  gint r, done = 0;
+  STATS_TIMER(t)
+
+  if (consumed)
+    *consumed = 0;
+
+  if (len == 0)
+    return 0;
+
+  if (len > FRIBIDI_MAX_STRING_LENGTH)
+    {
+#ifndef NO_STDIO
+	fprintf(stderr, "Fribidi can't handle strings > 65000 chars!\n");
+#endif
+      return 0;
+    }
+
+  fribidi_analyse_string(ctx, str, len, pbase_dir,
 			 /* output */
 			 &type_rl_list,
 			 &max_level);
 
-  for (pp = type_rl_list->next; pp->next; pp = pp->next)
+  if (!visual_bytes)
     {
-      gint i;
-      gint pos = RL_POS(pp);
-      gint len = RL_LEN(pp);
-      gint level = RL_LEVEL(pp);
-      for (i=0; i<len; i++)
-	embedding_level_list[pos + i] = level;
+      write_levels_and_maps(ctx, type_rl_list, max_level,
+			    position_L_to_V_list,
+			    position_V_to_L_list,
+			    embedding_level_list);
+      fribidi_type_link_list_free(ctx, type_rl_list);
+      return 0;
     }
-  
-  /* Free up the rl_list */
-  pp->next = free_type_links;
-  free_type_links = type_rl_list;
+
+  /* The visual order of the runs is found once, for the maps and for
+     the text */
+  write_levels_and_maps(ctx, type_rl_list, max_level,
+			NULL, NULL, embedding_level_list);
+  STATS_RESTART(t);
+
+  num_runs = find_visual_run_order(ctx, type_rl_list, max_level,
+				   &runs, &order);
+  fill_position_maps(runs, order, num_runs,
+		     position_L_to_V_list,
+		     position_V_to_L_list);
+
+  out = visual_bytes;
+  for (r=0; r<num_runs; r++)
+    {
+      TypeLink *run = runs[order[r]];
+      gint pos = RL_POS(run);
+      gint n = RL_LEN(run);
+      gboolean fits;
+
+      if (RL_LEVEL(run) % 2 == 0)
+	fits = encode_chars(char_set, str + pos, n, &out,
+			    size - (out - visual_bytes), &done);
+      else
+	{
+	  gint end = pos + n;
+
+	  fits = TRUE;
+	  while (end > pos && fits)
+	    {
+	      gint block_len = MIN(end - pos, ENCODE_BLOCK_CHARS);
+	      gint i;
+
+	      for (i=0; i<block_len; i++)
+		{
+		  FriBidiChar ch = str[end - 1 - i];
+
+		  fribidi_get_mirror_char(ch, &ch);
+		  block[i] = ch;
+		}
+	      STATS_ADD(ctx, mirror_lookups, block_len);
+	      fits = encode_chars(char_set, block, block_len, &out,
+				  size - (out - visual_bytes), &done);
+	      end -= block_len;
+	    }
+	}
+      if (!fits)
+	break;
+    }
+  STATS_LAP(ctx, t, FRIBIDI_PHASE_REORDER);
+
+  fribidi_context_free(ctx, order, sizeof(guint16) * num_runs);
+  fribidi_context_free(ctx, runs, sizeof(TypeLink*) * num_runs);
+  fribidi_type_link_list_free(ctx, type_rl_list);
+
+  if (consumed)
+    *consumed = done;
+  return out - visual_bytes;
 }
 
+gint fribidi_log2vis_to_charset(/* input */
+				FriBidiChar *str,
+				gint len,
+				FriBidiCharType *pbase_dir,
+				const FriBidiCharSet *char_set,
+				/* output */
+				guchar *visual_bytes,
+				gint size,
+				gint *consumed,
+				guint16 *position_L_to_V_list,
+				guint16 *position_V_to_L_list,
+				guint8  *embedding_level_list
+				)
+{
+  return fribidi_context_log2vis_to_charset(fribidi_default_context(),
+					    str, len, pbase_dir, char_set,
+					    visual_bytes, size, consumed,
+					    position_L_to_V_list,
+					    position_V_to_L_list,
+					    embedding_level_list);
+}
@@ -29,6 +29,9 @@ fribidi_get_mirror_char(/* Input */
 			FriBidiChar ch,
 			/* Output */
 			FriBidiChar *mirrored_ch);
+/* Turn the trace of fribidi_trace.h on or off for the calling thread.
+   Nothing is recorded unless the library is built with
+   FRIBIDI_ENABLE_TRACE. */
 void
 fribidi_set_debug(gboolean debug);
 
@@ -43,6 +46,18 @@ void fribidi_log2vis(/* input */
 		     guint8      *embedding_level_list
 		     );
 
+/* Like fribidi_log2vis() with the visual string written over str */
+void fribidi_log2vis_in_place(/* input and output */
+			      FriBidiChar *str,
+			      /* input */
+			      gint len,
+			      FriBidiCharType *pbase_dir,
+			      /* output */
+			      guint16 *position_L_to_V_list,
+			      guint16 *position_V_to_L_list,
+			      guint8  *embedding_level_list
+			      );
+
 void fribidi_log2vis_get_embedding_levels(
                      /* input */
 		     FriBidiChar *str,
@@ -52,6 +67,436 @@ void fribidi_log2vis_get_embedding_levels(
 		     guint8 *embedding_level_list
 		     );
 
+/* Reorder one line of a paragraph from the embedding levels of the
+   whole paragraph, as given by fribidi_log2vis_get_embedding_levels()
+   for the line's part of it. Breaking a paragraph into lines then
+   takes one analysis. visual_str must not be str; any of the outputs
+   may be NULL. */
+void fribidi_reorder_line(/* input */
+			  FriBidiChar *str,
+			  gint len,
+			  const guint8 *embedding_level_list,
+			  /* output */
+			  FriBidiChar *visual_str,
+			  guint16 *position_L_to_V_list,
+			  guint16 *position_V_to_L_list
+			  );
+
+/* Get the embedding levels as runs in logical order. Returns the
+   number of runs, of which at most max_runs are written. */
+gint fribidi_log2vis_get_level_runs(/* input */
+				    FriBidiChar *str,
+				    gint len,
+				    FriBidiCharType *pbase_dir,
+				    /* output */
+				    FriBidiLevelRun *level_runs,
+				    gint max_runs
+				    );
+
+/* fribidi_log2vis() that also gives the level runs, as
+   fribidi_log2vis_get_level_runs() does, from the same analysis.
+   level_runs may be NULL, and then 0 is returned. */
+gint fribidi_log2vis_level_runs(/* input */
+				FriBidiChar *str,
+				gint len,
+				FriBidiCharType *pbase_dir,
+				/* output */
+				FriBidiChar *visual_str,
+				guint16 *position_L_to_V_list,
+				guint16 *position_V_to_L_list,
+				guint8  *embedding_level_list,
+				FriBidiLevelRun *level_runs,
+				gint max_runs
+				);
+
+/* Get one bit per character that is set for the characters resolved
+   as right to left. rtl_mask must hold (len + 63) / 64 words. */
+void fribidi_log2vis_get_rtl_mask(/* input */
+				  FriBidiChar *str,
+				  gint len,
+				  FriBidiCharType *pbase_dir,
+				  /* output */
+				  guint64 *rtl_mask
+				  );
+
+/* fribidi_log2vis() that also gives the mask of
+   fribidi_log2vis_get_rtl_mask(), from the same analysis. rtl_mask
+   may be NULL. */
+void fribidi_log2vis_rtl_mask(/* input */
+			      FriBidiChar *str,
+			      gint len,
+			      FriBidiCharType *pbase_dir,
+			      /* output */
+			      FriBidiChar *visual_str,
+			      guint16 *position_L_to_V_list,
+			      guint16 *position_V_to_L_list,
+			      guint8  *embedding_level_list,
+			      guint64 *rtl_mask
+			      );
+
+/* Analyse a paragraph held in several segments. The maps and the
+   levels are indexed by the position in the whole paragraph. */
+void fribidi_log2vis_segments(/* input */
+			      FriBidiSegment *segments,
+			      gint num_segments,
+			      FriBidiCharType *pbase_dir,
+			      /* output */
+			      guint16 *position_L_to_V_list,
+			      guint16 *position_V_to_L_list,
+			      guint8  *embedding_level_list
+			      );
+
+/* Run the algorithm on UTF-8 text. The maps and the levels are in
+   bytes or in characters, and the number of their entries is
+   returned. Any of the outputs may be NULL. */
+gint fribidi_log2vis_utf8(/* input */
+			  guchar *str,
+			  gint len,
+			  FriBidiCharType *pbase_dir,
+			  FriBidiMapUnits units,
+			  /* output */
+			  guchar *visual_str,
+			  gint *position_L_to_V_list,
+			  gint *position_V_to_L_list,
+			  guint8 *embedding_level_list
+			  );
+
+/* The same for UTF-16 text, with the maps and the levels in 16 bit
+   units or in characters. */
+gint fribidi_log2vis_utf16(/* input */
+			   guint16 *str,
+			   gint len,
+			   FriBidiCharType *pbase_dir,
+			   FriBidiMapUnits units,
+			   /* output */
+			   guint16 *visual_str,
+			   gint *position_L_to_V_list,
+			   gint *position_V_to_L_list,
+			   guint8 *embedding_level_list
+			   );
+
+gint fribidi_log2vis_utf16_get_embedding_levels(
+			   /* input */
+			   guint16 *str,
+			   gint len,
+			   FriBidiCharType *pbase_dir,
+			   FriBidiMapUnits units,
+			   /* output */
+			   guint8 *embedding_level_list
+			   );
+
+/* Run the algorithm on text in an 8-bit character set. type_table
+   gives the bidi type of each byte, and mirror_table the byte it is
+   mirrored to. The maps and the levels are in bytes. Any of the
+   outputs may be NULL. fribidi_log2vis_charset() supplies the tables
+   of the character sets of fribidi_char_sets.h. */
+void fribidi_log2vis_8bit(/* input */
+			  const FriBidiCharType *type_table,
+			  const guchar *mirror_table,
+			  guchar *str,
+			  gint len,
+			  FriBidiCharType *pbase_dir,
+			  /* output */
+			  guchar *visual_str,
+			  guint16 *position_L_to_V_list,
+			  guint16 *position_V_to_L_list,
+			  guint8 *embedding_level_list
+			  );
+
+/* Like fribidi_log2vis(), but the visual string is written in the
+   character set of char_set as it is reordered, so that no visual
+   Unicode string is made. Returns the number of bytes written to
+   visual_bytes, which stops at the last character that fits in
+   size. Nothing is written after the last byte. If consumed is not
+   NULL, it is set to the number of visual characters written, so
+   that the string was cut if it is less than len. */
+gint fribidi_log2vis_to_charset(/* input */
+				FriBidiChar *str,
+				gint len,
+				FriBidiCharType *pbase_dir,
+				const FriBidiCharSet *char_set,
+				/* output */
+				guchar *visual_bytes,
+				gint size,
+				gint *consumed,
+				guint16 *position_L_to_V_list,
+				guint16 *position_V_to_L_list,
+				guint8  *embedding_level_list
+				);
+
+/*======================================================================
+//  The visual iterator walks an analysed paragraph in visual order,
+//  either a run or a character at a time, without writing the visual
+//  string or the position maps. Characters are mirrored as they are
+//  read. str must stay valid until fribidi_visual_iter_free().
+//
+//  Example:
+//
+//     FriBidiVisualIter iter;
+//     FriBidiChar ch;
+//
+//     fribidi_visual_iter_init(&iter, str, len, &base_dir);
+//     while (fribidi_visual_iter_next_char(&iter, &ch, NULL))
+//       draw_char(ch);
+//     fribidi_visual_iter_free(&iter);
+//
+//----------------------------------------------------------------------*/
+void fribidi_visual_iter_init(FriBidiVisualIter *iter,
+			      /* input */
+			      FriBidiChar *str,
+			      gint len,
+			      FriBidiCharType *pbase_dir);
+
+gboolean fribidi_visual_iter_next_run(FriBidiVisualIter *iter,
+				      /* output */
+				      FriBidiLevelRun *run);
+
+gboolean fribidi_visual_iter_next_char(FriBidiVisualIter *iter,
+				       /* output */
+				       FriBidiChar *ch,
+				       gint *log_pos);
+
+void fribidi_visual_iter_free(FriBidiVisualIter *iter);
+
+/* fribidi_mem.c */
+
+/*======================================================================
+//  The built in allocators. The arena allocator hands out memory from
+//  large blocks and releases all of it at once when it is reset.
+//----------------------------------------------------------------------*/
+extern FriBidiAllocator fribidi_allocator_glib;
+extern FriBidiAllocator fribidi_allocator_malloc;
+
+FriBidiAllocator *fribidi_allocator_arena_new(gsize block_size);
+void fribidi_allocator_arena_destroy(FriBidiAllocator *arena);
+
+/*======================================================================
+//  A context routes all the scratch memory of the algorithm to the
+//  given allocator, or to the default one if allocator is NULL. Call
+//  fribidi_context_reset() before the memory of the allocator is
+//  released wholesale.
+//----------------------------------------------------------------------*/
+FriBidiContext *fribidi_context_new(FriBidiAllocator *allocator);
+void fribidi_context_reset(FriBidiContext *ctx);
+void fribidi_context_destroy(FriBidiContext *ctx);
+
+void fribidi_context_log2vis(FriBidiContext *ctx,
+			     /* input */
+			     FriBidiChar *str,
+			     gint len,
+			     FriBidiCharType *pbase_dir,
+			     /* output */
+			     FriBidiChar *visual_str,
+			     guint16     *position_L_to_V_list,
+			     guint16     *position_V_to_L_list,
+			     guint8      *embedding_level_list
+			     );
+
+void fribidi_context_log2vis_in_place(FriBidiContext *ctx,
+				      /* input and output */
+				      FriBidiChar *str,
+				      /* input */
+				      gint len,
+				      FriBidiCharType *pbase_dir,
+				      /* output */
+				      guint16 *position_L_to_V_list,
+				      guint16 *position_V_to_L_list,
+				      guint8  *embedding_level_list
+				      );
+
+void fribidi_context_log2vis_get_embedding_levels(
+			     FriBidiContext *ctx,
+			     /* input */
+			     FriBidiChar *str,
+			     gint len,
+			     FriBidiCharType *pbase_dir,
+			     /* output */
+			     guint8 *embedding_level_list
+			     );
+
+void fribidi_context_reorder_line(FriBidiContext *ctx,
+				  /* input */
+				  FriBidiChar *str,
+				  gint len,
+				  const guint8 *embedding_level_list,
+				  /* output */
+				  FriBidiChar *visual_str,
+				  guint16 *position_L_to_V_list,
+				  guint16 *position_V_to_L_list
+				  );
+
+gint fribidi_context_log2vis_get_level_runs(
+			     FriBidiContext *ctx,
+			     /* input */
+			     FriBidiChar *str,
+			     gint len,
+			     FriBidiCharType *pbase_dir,
+			     /* output */
+			     FriBidiLevelRun *level_runs,
+			     gint max_runs
+			     );
+
+gint fribidi_context_log2vis_level_runs(FriBidiContext *ctx,
+					/* input */
+					FriBidiChar *str,
+					gint len,
+					FriBidiCharType *pbase_dir,
+					/* output */
+					FriBidiChar *visual_str,
+					guint16 *position_L_to_V_list,
+					guint16 *position_V_to_L_list,
+					guint8  *embedding_level_list,
+					FriBidiLevelRun *level_runs,
+					gint max_runs
+					);
+
+void fribidi_context_log2vis_get_rtl_mask(
+			     FriBidiContext *ctx,
+			     /* input */
+			     FriBidiChar *str,
+			     gint len,
+			     FriBidiCharType *pbase_dir,
+			     /* output */
+			     guint64 *rtl_mask
+			     );
+
+void fribidi_context_log2vis_rtl_mask(FriBidiContext *ctx,
+				      /* input */
+				      FriBidiChar *str,
+				      gint len,
+				      FriBidiCharType *pbase_dir,
+				      /* output */
+				      FriBidiChar *visual_str,
+				      guint16 *position_L_to_V_list,
+				      guint16 *position_V_to_L_list,
+				      guint8  *embedding_level_list,
+				      guint64 *rtl_mask
+				      );
+
+void fribidi_context_log2vis_segments(FriBidiContext *ctx,
+				      /* input */
+				      FriBidiSegment *segments,
+				      gint num_segments,
+				      FriBidiCharType *pbase_dir,
+				      /* output */
+				      guint16 *position_L_to_V_list,
+				      guint16 *position_V_to_L_list,
+				      guint8  *embedding_level_list
+				      );
+
+gint fribidi_context_log2vis_utf8(FriBidiContext *ctx,
+				  /* input */
+				  guchar *str,
+				  gint len,
+				  FriBidiCharType *pbase_dir,
+				  FriBidiMapUnits units,
+				  /* output */
+				  guchar *visual_str,
+				  gint *position_L_to_V_list,
+				  gint *position_V_to_L_list,
+				  guint8 *embedding_level_list
+				  );
+
+gint fribidi_context_log2vis_utf16(FriBidiContext *ctx,
+				   /* input */
+				   guint16 *str,
+				   gint len,
+				   FriBidiCharType *pbase_dir,
+				   FriBidiMapUnits units,
+				   /* output */
+				   guint16 *visual_str,
+				   gint *position_L_to_V_list,
+				   gint *position_V_to_L_list,
+				   guint8 *embedding_level_list
+				   );
+
+gint fribidi_context_log2vis_utf16_get_embedding_levels(
+				   FriBidiContext *ctx,
+				   /* input */
+				   guint16 *str,
+				   gint len,
+				   FriBidiCharType *pbase_dir,
+				   FriBidiMapUnits units,
+				   /* output */
+				   guint8 *embedding_level_list
+				   );
+
+void fribidi_context_log2vis_8bit(FriBidiContext *ctx,
+				  /* input */
+				  const FriBidiCharType *type_table,
+				  const guchar *mirror_table,
+				  guchar *str,
+				  gint len,
+				  FriBidiCharType *pbase_dir,
+				  /* output */
+				  guchar *visual_str,
+				  guint16 *position_L_to_V_list,
+				  guint16 *position_V_to_L_list,
+				  guint8 *embedding_level_list
+				  );
+
+gint fribidi_context_log2vis_to_charset(FriBidiContext *ctx,
+					/* input */
+					FriBidiChar *str,
+					gint len,
+					FriBidiCharType *pbase_dir,
+					const FriBidiCharSet *char_set,
+					/* output */
+					guchar *visual_bytes,
+					gint size,
+					gint *consumed,
+					guint16 *position_L_to_V_list,
+					guint16 *position_V_to_L_list,
+					guint8  *embedding_level_list
+					);
+
+void fribidi_context_visual_iter_init(FriBidiContext *ctx,
+				      FriBidiVisualIter *iter,
+				      /* input */
+				      FriBidiChar *str,
+				      gint len,
+				      FriBidiCharType *pbase_dir);
+
+/*======================================================================
+//  Memory limits and statistics. The pool limit bounds the memory of
+//  released links that is kept for reuse between calls, and
+//  fribidi_trim_memory() gives all of it back. The fribidi_context_
+//  variants act on a given context, the others on the default one.
+//----------------------------------------------------------------------*/
+void fribidi_set_memory_pool_limit(gsize max_pooled_bytes);
+void fribidi_trim_memory(void);
+void fribidi_get_memory_stats(/* output */
+			      FriBidiMemoryStats *stats);
+
+void fribidi_context_set_memory_pool_limit(FriBidiContext *ctx,
+					   gsize max_pooled_bytes);
+void fribidi_context_trim_memory(FriBidiContext *ctx);
+void fribidi_context_get_memory_stats(FriBidiContext *ctx,
+				      /* output */
+				      FriBidiMemoryStats *stats);
+
+/* fribidi_stats.c */
+
+/*======================================================================
+//  Statistics of the engine: the time spent in each phase of the
+//  algorithm and counts of its work, summed over the calls since the
+//  context was made or its statistics were reset. They are only
+//  gathered when the library is built with FRIBIDI_ENABLE_STATS, which
+//  fribidi_stats_enabled() tells; otherwise they read as zeros and
+//  cost nothing.
+//----------------------------------------------------------------------*/
+gboolean fribidi_stats_enabled(void);
+const gchar *fribidi_phase_name(FriBidiPhase phase);
+
+void fribidi_get_stats(/* output */
+		       FriBidiStats *stats);
+void fribidi_reset_stats(void);
+
+void fribidi_context_get_stats(FriBidiContext *ctx,
+			       /* output */
+			       FriBidiStats *stats);
+void fribidi_context_reset_stats(FriBidiContext *ctx);
+
 /* fribidi_utils.c */
 
 /*======================================================================
@@ -122,6 +567,76 @@ fribidi_is_char_rtl(guint8 *embedding_level_list,
 		    FriBidiCharType base_dir,
 		    int idx);
 
+/*======================================================================
+//  Conversion between positions in a paragraph held in segments and
+//  (segment, offset) pairs. fribidi_segments_locate() returns FALSE if
+//  idx is beyond the end of the paragraph.
+//----------------------------------------------------------------------*/
+gboolean
+fribidi_segments_locate(FriBidiSegment *segments,
+			gint num_segments,
+			gint idx,
+			/* output */
+			gint *segment,
+			gint *offset);
+
+gint
+fribidi_segments_index(FriBidiSegment *segments,
+		       gint segment,
+		       gint offset);
+
+/*======================================================================
+//  Lookups in the level runs of fribidi_log2vis_get_level_runs(). The
+//  runs are searched by bisection. fribidi_level_runs_find() returns
+//  the index of the run that holds the character idx, or -1 if no run
+//  holds it, and fribidi_level_runs_level_at() returns the level of
+//  the character, or -1.
+//----------------------------------------------------------------------*/
+gint
+fribidi_level_runs_find(FriBidiLevelRun *level_runs,
+			gint num_runs,
+			gint idx);
+
+gint
+fribidi_level_runs_level_at(FriBidiLevelRun *level_runs,
+			    gint num_runs,
+			    gint idx);
+
+gboolean
+fribidi_level_runs_is_rtl_at(FriBidiLevelRun *level_runs,
+			     gint num_runs,
+			     gint idx);
+
+/*======================================================================
+//  Queries on the mask of fribidi_log2vis_rtl_mask() or
+//  fribidi_log2vis_get_rtl_mask(), that work on 64 characters at a
+//  time.
+//
+//  fribidi_rtl_mask_count() counts the rtl characters in [start, end).
+//
+//  fribidi_rtl_mask_next_change() returns the index of the first
+//  character after idx with the other direction than idx, or len if
+//  there is none.
+//
+//  fribidi_rtl_mask_expand() writes the direction of each character
+//  as a level of 1 for rtl and 0 for ltr.
+//----------------------------------------------------------------------*/
+gint
+fribidi_rtl_mask_count(guint64 *rtl_mask,
+		       gint start,
+		       gint end);
+
+gint
+fribidi_rtl_mask_next_change(guint64 *rtl_mask,
+			     gint len,
+			     gint idx);
+
+void
+fribidi_rtl_mask_expand(guint64 *rtl_mask,
+			gint len,
+			/* output */
+			guint8 *levels);
+
 /*======================================================================
 //  fribidi_xpos_resolve() does the complicated translation of
 //  an x-coordinate, e.g. as received through a mouse press event,
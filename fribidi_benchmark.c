@@ -16,36 +16,701 @@
  * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
  * Boston, MA 02111-1307, USA.
  */
+
+/*======================================================================
+//  The benchmark times each entry point of the library on a set of
+//  named corpora. A corpus is generated from a fixed seed, so that
+//  runs on different machines or of different versions time the same
+//  text.
+//
+//  For every corpus and entry point the number of calls in a
+//  repetition is doubled until a repetition takes at least the minimum
+//  time. After the warm-up repetitions, the median and the fastest of
+//  the timed repetitions are reported in nanoseconds per character of
+//  the corpus. The csv format has one line per measurement, to compare
+//  runs with other tools.
+//----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
-#include <sys/times.h>
+#include <string.h>
+#include <time.h>
 #include "fribidi.h"
 
 #define TEST_STRING "a THE QUICK BROWN 123,456 (FOX JUMPS OVER) THE LAZY DOG the quick brown fox jumps over the lazy dog THE QUICK BROWN FOX JUMPS 123,456 OVER THE LAZY DOG"
 
+/* The nested corpus alternates right to left and left to right
+   embeddings down to NESTING_DEPTH levels, with some text in each. */
+#define NESTING_DEPTH 30
+#define UNI_LRE 0x202A
+#define UNI_RLE 0x202B
+#define UNI_PDF 0x202C
+
+#define UNI_ARABIC_COMMA 0x060C
+#define UNI_ARABIC_ZERO 0x0660
+
+#define CORPUS_SEED 12345
+
 #define CASE(s) if (strcmp(S_, s) == 0)
 
-double utime ()
+/*======================================================================
+//  Generation of the corpora.
+//----------------------------------------------------------------------*/
+typedef struct {
+  FriBidiChar *us;
+  gint len;
+  gint pos;
+  guint32 seed;
+} Generator;
+
+typedef struct {
+  FriBidiChar letters[64];
+  gint num_letters;
+} Alphabet;
+
+static Alphabet latin, hebrew, arabic;
+
+static void
+init_alphabets(void)
+{
+  FriBidiChar ch;
+
+  for (ch = 'a'; ch <= 'z'; ch++)
+    latin.letters[latin.num_letters++] = ch;
+  for (ch = 0x05D0; ch <= 0x05EA; ch++)
+    hebrew.letters[hebrew.num_letters++] = ch;
+  for (ch = 0x0627; ch <= 0x063A; ch++)
+    arabic.letters[arabic.num_letters++] = ch;
+  for (ch = 0x0641; ch <= 0x064A; ch++)
+    arabic.letters[arabic.num_letters++] = ch;
+}
+
+/* A number in [0, n) */
+static gint
+random_below(Generator *g,
+	     gint n)
+{
+  g->seed = g->seed * 1103515245 + 12345;
+  return (g->seed >> 16) % n;
+}
+
+static void
+put_char(Generator *g,
+	 FriBidiChar ch)
+{
+  if (g->pos < g->len)
+    g->us[g->pos++] = ch;
+}
+
+static void
+put_string(Generator *g,
+	   const gchar *s)
+{
+  while (*s)
+    put_char(g, (guchar)*s++);
+}
+
+static void
+put_word(Generator *g,
+	 const Alphabet *alphabet)
+{
+  gint n = 2 + random_below(g, 7);
+
+  while (n--)
+    put_char(g, alphabet->letters[random_below(g, alphabet->num_letters)]);
+}
+
+/* A number in one of the common forms, with the digits from zero up.
+   If zero is 0 the digits are European or Arabic-Indic at random. */
+static void
+put_number(Generator *g,
+	   FriBidiChar zero)
+{
+  gint form = random_below(g, 6);
+  gint n = 1 + random_below(g, 6);
+  gint i;
+
+  if (zero == 0)
+    zero = random_below(g, 2) ? '0' : UNI_ARABIC_ZERO;
+
+  if (form == 1)
+    put_char(g, random_below(g, 2) ? '+' : '-');
+  else if (form == 2)
+    put_char(g, '$');
+  for (i = 0; i < n; i++)
+    {
+      if (form == 3 && i > 0 && (n - i) % 3 == 0)
+	put_char(g, ',');
+      put_char(g, zero + random_below(g, 10));
+    }
+  if (form == 4)
+    {
+      put_char(g, '.');
+      put_char(g, zero + random_below(g, 10));
+      put_char(g, zero + random_below(g, 10));
+    }
+  else if (form == 5)
+    put_char(g, '%');
+}
+
+/* A sentence of words from alphabet. A word is a number numbers_pct
+   percent of the time, and a phrase from other, if it is given, some
+   of the time. */
+static void
+put_sentence(Generator *g,
+	     const Alphabet *alphabet,
+	     const Alphabet *other,
+	     gint numbers_pct,
+	     FriBidiChar zero,
+	     FriBidiChar comma)
+{
+  gint n = 5 + random_below(g, 11);
+  gint i;
+
+  for (i = 0; i < n && g->pos < g->len; i++)
+    {
+      gint r = random_below(g, 100);
+
+      if (i > 0)
+	{
+	  if (random_below(g, 8) == 0)
+	    put_char(g, comma);
+	  put_char(g, ' ');
+	}
+      if (r < numbers_pct)
+	put_number(g, zero);
+      else if (other && r < numbers_pct + 15)
+	{
+	  gint words = 1 + random_below(g, 3);
+	  gboolean paren = random_below(g, 3) == 0;
+
+	  if (paren)
+	    put_char(g, '(');
+	  while (words--)
+	    {
+	      put_word(g, other);
+	      if (words)
+		put_char(g, ' ');
+	    }
+	  if (paren)
+	    put_char(g, ')');
+	}
+      else
+	put_word(g, alphabet);
+    }
+  put_string(g, random_below(g, 5) ? ". " : "? ");
+}
+
+static void
+build_default(Generator *g)
+{
+  gint i;
+
+  /* The string of the original benchmark, with capitals in Hebrew */
+  for (i = 0; TEST_STRING[i]; i++)
+    {
+      FriBidiChar ch = (guchar)TEST_STRING[i];
+
+      if (ch >= 'A' && ch <= 'Z')
+	ch += 0x05D0 - 'A';
+      put_char(g, ch);
+    }
+}
+
+static void
+build_ascii(Generator *g)
+{
+  while (g->pos < g->len)
+    put_sentence(g, &latin, NULL, 5, '0', ',');
+}
+
+static void
+build_hebrew(Generator *g)
 {
-  struct tms tb;
-  times(&tb);
-  return 0.01 * tb.tms_utime;
+  while (g->pos < g->len)
+    put_sentence(g, &hebrew, NULL, 0, '0', ',');
+}
+
+static void
+build_arabic_numbers(Generator *g)
+{
+  while (g->pos < g->len)
+    put_sentence(g, &arabic, NULL, 25, '0', UNI_ARABIC_COMMA);
+}
+
+static void
+build_mixed(Generator *g)
+{
+  while (g->pos < g->len)
+    {
+      if (random_below(g, 2))
+	put_sentence(g, &hebrew, &latin, 10, '0', ',');
+      else
+	put_sentence(g, &latin, &hebrew, 10, '0', ',');
+    }
+}
+
+/* English with Hebrew phrases in it, where runs of ASCII are cut short
+   all the time */
+static void
+build_english_hebrew(Generator *g)
+{
+  while (g->pos < g->len)
+    put_sentence(g, &latin, &hebrew, 10, '0', ',');
+}
+
+static void
+build_digits(Generator *g)
+{
+  while (g->pos < g->len)
+    put_sentence(g, &hebrew, &latin, 70, 0, ',');
+}
+
+static void
+build_nested(Generator *g)
+{
+  gint i;
+
+  for (i = 0; i < NESTING_DEPTH; i++)
+    {
+      put_char(g, (i % 2) ? UNI_LRE : UNI_RLE);
+      if (i % 2)
+	put_string(g, "ab 1 ");
+      else
+	{
+	  put_char(g, 0x05D0);
+	  put_char(g, 0x05D1);
+	  put_string(g, " 2 ");
+	}
+    }
+  for (i = 0; i < NESTING_DEPTH; i++)
+    put_char(g, UNI_PDF);
+  put_char(g, ' ');
+  for (i = 0; i < 7; i++)
+    put_char(g, 0x05D0 + i);
+}
+
+typedef struct {
+  const gchar *name;
+  const gchar *title;
+  gint len;                     /* 0 for as long as it is built */
+  gint char_set;                /* Of the 8-bit entry points */
+  void (*build) (Generator *g);
+} Corpus;
+
+static const Corpus corpora[] = {
+  { "default", "The string of the original benchmark",
+    0, FRIBIDI_CHARSET_8859_8, build_default },
+  { "ascii", "English sentences", 4096, FRIBIDI_CHARSET_8859_8,
+    build_ascii },
+  { "hebrew", "Hebrew sentences", 4096, FRIBIDI_CHARSET_8859_8,
+    build_hebrew },
+  { "arabic_numbers", "Arabic sentences with numbers", 4096,
+    FRIBIDI_CHARSET_CP1256, build_arabic_numbers },
+  { "mixed", "Hebrew and English sentences", 4096, FRIBIDI_CHARSET_8859_8,
+    build_mixed },
+  { "english_hebrew", "English with Hebrew phrases, 100k characters",
+    100000, FRIBIDI_CHARSET_8859_8, build_english_hebrew },
+  { "digits", "Numbers in both kinds of digits", 4096,
+    FRIBIDI_CHARSET_8859_8, build_digits },
+  { "nested", "Explicit embeddings 30 levels deep",
+    0, FRIBIDI_CHARSET_8859_8, build_nested },
+  { "long_1k", "A mixed paragraph of 1k characters", 1 << 10,
+    FRIBIDI_CHARSET_8859_8, build_mixed },
+  { "long_16k", "A mixed paragraph of 16k characters", 1 << 14,
+    FRIBIDI_CHARSET_8859_8, build_mixed },
+  { "long_64k", "The longest mixed paragraph the maps can hold",
+    FRIBIDI_MAX_STRING_LENGTH, FRIBIDI_CHARSET_8859_8, build_mixed },
+  { "long_1m", "A mixed paragraph of 1M characters", 1 << 20,
+    FRIBIDI_CHARSET_8859_8, build_mixed },
+  { NULL }
+};
+
+/* The longest corpus that is built to its end rather than to a length */
+#define MAX_BUILT_LEN 1024
+
+/*======================================================================
+//  The entry points. Each is called with the corpus in every form it
+//  may take, and with output buffers large enough for any of them.
+//----------------------------------------------------------------------*/
+typedef struct {
+  FriBidiContext *ctx;
+  const FriBidiCharSet *utf8_set;
+  const FriBidiCharSet *char_set;  /* Of the 8-bit entry points */
+
+  FriBidiChar *us;
+  gint len;
+  guchar *utf8;
+  gint utf8_len;
+  guchar *bytes;                /* The corpus in char_set, or NULL */
+
+  FriBidiChar *out_us;
+  guchar *out_bytes;
+  gint out_size;
+  guint16 *L2V, *V2L;
+  gint *int_L2V, *int_V2L;
+  guint8 *levels;
+} Bench;
+
+static void
+run_log2vis(Bench *b)
+{
+  FriBidiCharType base = FRIBIDI_TYPE_N;
+
+  fribidi_context_log2vis(b->ctx, b->us, b->len, &base,
+			  b->out_us, b->L2V, b->V2L, b->levels);
+}
+
+static void
+run_levels(Bench *b)
+{
+  FriBidiCharType base = FRIBIDI_TYPE_N;
+
+  fribidi_context_log2vis_get_embedding_levels(b->ctx, b->us, b->len, &base,
+					       b->levels);
+}
+
+static void
+run_log2vis_utf8(Bench *b)
+{
+  FriBidiCharType base = FRIBIDI_TYPE_N;
+
+  fribidi_context_log2vis_utf8(b->ctx, b->utf8, b->utf8_len, &base,
+			       FRIBIDI_MAP_CHARS, b->out_bytes,
+			       b->int_L2V, b->int_V2L, b->levels);
+}
+
+static void
+run_to_charset_utf8(Bench *b)
+{
+  FriBidiCharType base = FRIBIDI_TYPE_N;
+
+  fribidi_context_log2vis_to_charset(b->ctx, b->us, b->len, &base,
+				     b->utf8_set, b->out_bytes, b->out_size, NULL,
+				     b->L2V, b->V2L, b->levels);
+}
+
+static void
+run_utf8_decode(Bench *b)
+{
+  gint error_pos;
+
+  fribidi_utf8_to_unicode_checked(b->utf8, b->utf8_len, b->out_us,
+				  &error_pos);
+}
+
+static void
+run_utf8_encode(Bench *b)
+{
+  gint consumed;
+
+  fribidi_unicode_to_utf8_chunk(b->us, b->len, b->out_bytes, b->out_size,
+				&consumed);
+}
+
+static void
+run_8bit_log2vis(Bench *b)
+{
+  FriBidiCharType base = FRIBIDI_TYPE_N;
+
+  fribidi_context_log2vis_charset(b->ctx, b->char_set->id, b->bytes, b->len,
+				  &base, b->out_bytes, b->L2V, b->V2L,
+				  b->levels);
+}
+
+static void
+run_8bit_decode(Bench *b)
+{
+  gint consumed;
+
+  b->char_set->decode(b->char_set, b->bytes, b->len, b->out_us, b->len,
+		      &consumed);
+}
+
+static void
+run_8bit_encode(Bench *b)
+{
+  gint consumed;
+
+  b->char_set->encode(b->char_set, b->us, b->len, b->out_bytes, b->out_size,
+		      &consumed);
+}
+
+typedef struct {
+  const gchar *name;
+  const gchar *title;
+  gboolean limited;             /* To FRIBIDI_MAX_STRING_LENGTH characters */
+  gboolean uses_context;
+  gboolean needs_8bit;
+  void (*run) (Bench *b);
+} Api;
+
+static const Api apis[] = {
+  { "log2vis", "fribidi_log2vis()", TRUE, TRUE, FALSE, run_log2vis },
+  { "levels", "fribidi_log2vis_get_embedding_levels()",
+    FALSE, TRUE, FALSE, run_levels },
+  { "log2vis_utf8", "fribidi_log2vis_utf8() on the UTF-8 form",
+    TRUE, TRUE, FALSE, run_log2vis_utf8 },
+  { "to_charset_utf8", "fribidi_log2vis_to_charset() to UTF-8",
+    TRUE, TRUE, FALSE, run_to_charset_utf8 },
+  { "utf8_decode", "fribidi_utf8_to_unicode_checked()",
+    FALSE, FALSE, FALSE, run_utf8_decode },
+  { "utf8_encode", "fribidi_unicode_to_utf8_chunk()",
+    FALSE, FALSE, FALSE, run_utf8_encode },
+  { "8bit_log2vis", "fribidi_log2vis_charset() on the 8-bit form",
+    TRUE, TRUE, TRUE, run_8bit_log2vis },
+  { "8bit_decode", "The decoder of the 8-bit set",
+    FALSE, FALSE, TRUE, run_8bit_decode },
+  { "8bit_encode", "The encoder of the 8-bit set",
+    FALSE, FALSE, TRUE, run_8bit_encode },
+  { NULL }
+};
+
+/* Build the corpus and its forms. The 8-bit form is left out if the
+   corpus has characters that its set does not have. */
+static void
+bench_init(Bench *b,
+	   const Corpus *corpus)
+{
+  Generator g;
+  gint consumed, n, i;
+
+  g.len = corpus->len ? corpus->len : MAX_BUILT_LEN;
+  g.us = malloc(sizeof(FriBidiChar) * (g.len + 1));
+  g.pos = 0;
+  g.seed = CORPUS_SEED;
+  corpus->build(&g);
+
+  b->ctx = NULL;
+  b->us = g.us;
+  b->len = g.pos;
+  b->us[b->len] = 0;
+  b->out_size = 4 * b->len + 4;
+
+  /* fribidi_log2vis() copies the terminating zero too */
+  b->out_us = malloc(sizeof(FriBidiChar) * (b->len + 1));
+  b->out_bytes = malloc(b->out_size);
+  b->L2V = malloc(sizeof(guint16) * b->len);
+  b->V2L = malloc(sizeof(guint16) * b->len);
+  b->int_L2V = malloc(sizeof(gint) * b->out_size);
+  b->int_V2L = malloc(sizeof(gint) * b->out_size);
+  b->levels = malloc(b->out_size);
+
+  b->utf8_set = fribidi_char_set_by_id(FRIBIDI_CHARSET_UTF8);
+  b->utf8 = malloc(b->out_size);
+  b->utf8_len = b->utf8_set->encode(b->utf8_set, b->us, b->len,
+				    b->utf8, b->out_size, &consumed);
+
+  b->char_set = fribidi_char_set_by_id(corpus->char_set);
+  b->bytes = malloc(b->len);
+  b->char_set->encode(b->char_set, b->us, b->len, b->bytes, b->len,
+		      &consumed);
+  n = b->char_set->decode(b->char_set, b->bytes, b->len, b->out_us, b->len,
+			  &consumed);
+  for (i = 0; i < n && b->out_us[i] == b->us[i]; i++)
+    ;
+  if (consumed != b->len || i != b->len)
+    {
+      free(b->bytes);
+      b->bytes = NULL;
+    }
+}
+
+static void
+bench_free(Bench *b)
+{
+  free(b->us);
+  free(b->utf8);
+  free(b->bytes);
+  free(b->out_us);
+  free(b->out_bytes);
+  free(b->L2V);
+  free(b->V2L);
+  free(b->int_L2V);
+  free(b->int_V2L);
+  free(b->levels);
+}
+
+/*======================================================================
+//  Timing.
+//----------------------------------------------------------------------*/
+typedef struct {
+  gint niter;                   /* Calls in a repetition */
+  double median_ns;             /* Per character */
+  double min_ns;
+  gsize peak_bytes;
+  FriBidiStats stats;           /* Of the timed repetitions */
+} Result;
+
+static double
+now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Time niter calls. An arena is reset after every call, as it would be
+   at the end of a request. */
+static double
+time_calls(const Api *api,
+	   Bench *b,
+	   gboolean reset,
+	   gint niter)
+{
+  double t0 = now_ns();
+  gint i;
+
+  for (i = 0; i < niter; i++)
+    {
+      api->run(b);
+      if (reset)
+	fribidi_context_reset(b->ctx);
+    }
+  return now_ns() - t0;
+}
+
+static int
+compare_doubles(const void *a,
+		const void *b)
+{
+  double x = *(const double *) a, y = *(const double *) b;
+
+  return x < y ? -1 : x > y;
+}
+
+static void
+run_benchmark(const Api *api,
+	      Bench *b,
+	      FriBidiAllocator *allocator,
+	      gint niter,
+	      double min_time_ns,
+	      gint warmup,
+	      gint reps,
+	      /* output */
+	      Result *result)
+{
+  gboolean reset = allocator->reset != NULL;
+  double *times = malloc(sizeof(double) * reps);
+  FriBidiMemoryStats stats;
+  gint i;
+
+  b->ctx = fribidi_context_new(allocator);
+
+  if (niter <= 0)
+    for (niter = 1;
+	 niter < G_MAXINT / 2 && time_calls(api, b, reset, niter) < min_time_ns;
+	 niter *= 2)
+      ;
+  for (i = 0; i < warmup; i++)
+    time_calls(api, b, reset, niter);
+  fribidi_context_reset_stats(b->ctx);
+  for (i = 0; i < reps; i++)
+    times[i] = time_calls(api, b, reset, niter) / niter / b->len;
+  qsort(times, reps, sizeof(double), compare_doubles);
+
+  result->niter = niter;
+  result->min_ns = times[0];
+  result->median_ns = (reps % 2) ? times[reps / 2]
+    : (times[reps / 2 - 1] + times[reps / 2]) / 2;
+
+  fribidi_context_get_memory_stats(b->ctx, &stats);
+  result->peak_bytes = api->uses_context ? stats.peak_bytes : 0;
+  fribidi_context_get_stats(b->ctx, &result->stats);
+
+  fribidi_context_destroy(b->ctx);
+  b->ctx = NULL;
+  free(times);
+}
+
+/*======================================================================
+//  print_stats() prints the statistics of the engine, with the time of
+//  each phase per character and the counters per call, as columns of
+//  the csv format or as a line under the result.
+//----------------------------------------------------------------------*/
+static void
+print_stats_header(void)
+{
+  gint phase;
+
+  for (phase = 0; phase < FRIBIDI_NUM_PHASES; phase++)
+    printf(",%s_cycles_per_char", fribidi_phase_name(phase));
+  printf(",runs_per_call,merges_per_call,mirror_lookups_per_call,"
+	 "reversals_per_call");
+}
+
+static void
+print_stats(const Result *result,
+	    gint reps,
+	    gint len,
+	    gboolean do_csv)
+{
+  const FriBidiStats *stats = &result->stats;
+  double calls = (double) result->niter * reps;
+  gint phase;
+
+  if (!do_csv)
+    printf("%-16s", "");
+  for (phase = 0; phase < FRIBIDI_NUM_PHASES; phase++)
+    {
+      double cycles = stats->phase_cycles[phase] / calls / len;
+
+      if (do_csv)
+	printf(",%.3f", cycles);
+      else
+	printf(" %s %.2f", fribidi_phase_name(phase), cycles);
+    }
+  if (do_csv)
+    printf(",%.2f,%.2f,%.2f,%.2f\n",
+	   stats->runs_created / calls, stats->compact_merges / calls,
+	   stats->mirror_lookups / calls, stats->reversals / calls);
+  else
+    printf("\n%-16s runs %.1f merges %.1f mirror lookups %.1f"
+	   " reversals %.1f\n", "",
+	   stats->runs_created / calls, stats->compact_merges / calls,
+	   stats->mirror_lookups / calls, stats->reversals / calls);
+}
+
+/* Whether name is in the comma separated list, or the list is "all" */
+static gboolean
+is_selected(const gchar *list,
+	    const gchar *name)
+{
+  gint len = strlen(name);
+
+  if (strcmp(list, "all") == 0)
+    return TRUE;
+  while (*list)
+    {
+      const gchar *end = strchr(list, ',');
+
+      if (!end)
+	end = list + strlen(list);
+      if (end - list == len && strncmp(list, name, len) == 0)
+	return TRUE;
+      list = *end ? end + 1 : end;
+    }
+  return FALSE;
 }
 
 int main(int argc, char *argv[])
 {
   int argp=1;
-  guchar S_[255];
-  FriBidiChar us[255];
-  int len;
-  FriBidiChar out_us[255];
-  guint16 positionLtoV[255], positionVtoL[255];
-  guint8 embedding_list[255];
-  FriBidiCharType base;
+  int niter = 0;
+  int reps = 5;
+  int warmup = 1;
+  double min_time_ms = 20;
+  gchar *alloc_name = "glib";
+  gchar *corpus_names = "all";
+  gchar *api_names = "all";
+  gboolean do_csv = FALSE;
+  gboolean do_list = FALSE;
+  gboolean do_stats = FALSE;
+  static gchar *alloc_names[] = { "glib", "malloc", "arena" };
+  const Corpus *corpus;
+  const Api *api;
   int i;
-  int niter = 1000;
-  double time0, time1;
-  
+
   while(argp< argc && argv[argp][0] == '-')
     {
       gchar *S_ = argv[argp++];
@@ -55,55 +720,182 @@ int main(int argc, char *argv[])
 	       "fribidi_benchmark - A program for benchmarking the fribid library\n"
 	       "\n"
 	       "Syntax:\n"
-	       "    fribidi_benchmark -niter niter\n"
+	       "    fribidi_benchmark [-corpus corpora] [-api apis] [-alloc alloc]\n"
+	       "                      [-reps n] [-warmup n] [-min_time ms]\n"
+	       "                      [-niter niter] [-format format] [-stats]\n"
+	       "                      [-list]\n"
 	       "\n"
 	       "Description:\n"
-	       "    A program for benchmarking the speed of the BiDi algorithm.\n"
+	       "    A program for benchmarking the speed of the BiDi algorithm\n"
+	       "    and of the character set conversions on generated text.\n"
 	       "\n"
 	       "Options:\n"
-	       "    -niter niter  Number of iterations. Default is 1000.\n"
+	       "    -corpus corpora  Comma separated corpora to use, or all.\n"
+	       "                  Default is all.\n"
+	       "    -api apis     Comma separated entry points to time, or all.\n"
+	       "                  Default is all.\n"
+	       "    -alloc alloc  Allocator to use: glib, malloc, arena, or all\n"
+	       "                  to compare them. Default is glib.\n"
+	       "    -reps n       Number of timed repetitions. Default is 5.\n"
+	       "    -warmup n     Number of repetitions before the timed ones.\n"
+	       "                  Default is 1.\n"
+	       "    -min_time ms  Shortest time of a repetition. Default is 20.\n"
+	       "    -niter niter  Number of calls in a repetition, instead of\n"
+	       "                  as many as take the shortest time.\n"
+	       "    -format format  text, or csv for one line per measurement.\n"
+	       "    -stats        Show the time of each phase of the algorithm\n"
+	       "                  per character, and its counters per call. The\n"
+	       "                  library must be built with FRIBIDI_ENABLE_STATS.\n"
+	       "    -list         List the corpora and the entry points.\n"
 	       );
 	exit(0);
       }
 
-      CASE("-niter")  { niter = atoi(argv[argp++]); continue; };
+      CASE("-corpus")   { corpus_names = argv[argp++]; continue; };
+      CASE("-api")      { api_names = argv[argp++]; continue; };
+      CASE("-alloc")    { alloc_name = argv[argp++]; continue; };
+      CASE("-reps")     { reps = atoi(argv[argp++]); continue; };
+      CASE("-warmup")   { warmup = atoi(argv[argp++]); continue; };
+      CASE("-min_time") { min_time_ms = atof(argv[argp++]); continue; };
+      CASE("-niter")    { niter = atoi(argv[argp++]); continue; };
+      CASE("-stats")    { do_stats++; continue; };
+      CASE("-list")     { do_list++; continue; };
+      CASE("-format")
+	{
+	  S_ = argv[argp++];
+	  CASE("csv")  { do_csv = TRUE; continue; };
+	  CASE("text") { do_csv = FALSE; continue; };
+	  fprintf(stderr, "Unknown format %s!\n", S_);
+	  exit(1);
+	};
       fprintf(stderr, "Unknown option %s!\n", S_);
       exit(0);
     }
-  
-
-  strcpy(S_, TEST_STRING);
-  len= strlen(S_);
-
-  /* Map capital to iso Hebrew */
-  for (i=0; i<len; i++)
-    if (S_[i]>='A' && S_[i]<='Z')
-      S_[i]+= 0xE0 - 'A';  /* Map to iso Hebrew */
-
-  fribidi_iso8859_8_to_unicode(S_, us);
-
-  /* Start timer */
-  time0 = utime();
-
-  for (i=0; i<niter; i++) {
-    /* Create a bidi string */
-    base = FRIBIDI_TYPE_N;
-    fribidi_log2vis(us, len, &base, 
-		    /* output */
-		    out_us,
-		    positionVtoL,
-		    positionLtoV,
-		    embedding_list
-		    );
-  }
-
-  /* stop timer */
-  time1 = utime();
-  
-  /* output result */
-  printf("len = %d\n", len);
-  printf("%d iterations in %f seconds\n", niter, time1-time0);
-  printf("= %f iterations/second\n", 1.0 * niter/(time1-time0));
-  
+
+  if (do_list)
+    {
+      printf("Corpora:\n");
+      for (corpus = corpora; corpus->name; corpus++)
+	printf("    %-16s %s\n", corpus->name, corpus->title);
+      printf("Entry points:\n");
+      for (api = apis; api->name; api++)
+	printf("    %-16s %s\n", api->name, api->title);
+      return 0;
+    }
+
+  if (reps < 1)
+    reps = 1;
+
+  for (corpus = corpora; corpus->name; corpus++)
+    if (is_selected(corpus_names, corpus->name))
+      break;
+  if (!corpus->name)
+    {
+      fprintf(stderr, "Unknown corpus %s!\n", corpus_names);
+      exit(1);
+    }
+
+  if (do_stats && !fribidi_stats_enabled())
+    {
+      fprintf(stderr, "The library is built without FRIBIDI_ENABLE_STATS!\n");
+      exit(1);
+    }
+
+  init_alphabets();
+
+  if (do_csv)
+    {
+      printf("corpus,chars,api,alloc,iterations,reps,"
+	     "ns_per_char_median,ns_per_char_min,chars_per_sec,peak_bytes");
+      if (do_stats)
+	print_stats_header();
+      printf("\n");
+    }
+  else
+    printf("%-16s %8s %-16s %-6s %10s %10s %14s %10s\n",
+	   "corpus", "chars", "api", "alloc", "ns/char", "min", "chars/sec",
+	   "peak");
+
+  for (corpus = corpora; corpus->name; corpus++)
+    {
+      Bench b;
+
+      if (!is_selected(corpus_names, corpus->name))
+	continue;
+
+      bench_init(&b, corpus);
+
+      for (api = apis; api->name; api++)
+	{
+	  gboolean timed = FALSE;
+
+	  if (!is_selected(api_names, api->name))
+	    continue;
+
+	  if ((api->limited && b.len > FRIBIDI_MAX_STRING_LENGTH)
+	      || (api->needs_8bit && !b.bytes))
+	    {
+	      if (!do_csv)
+		printf("%-16s %8d %-16s %-6s %s\n", corpus->name, b.len,
+		       api->name, "-",
+		       api->needs_8bit && !b.bytes
+		       ? "skipped, not in the 8-bit set"
+		       : "skipped, longer than the library takes");
+	      continue;
+	    }
+
+	  for (i=0; i<3; i++)
+	    {
+	      FriBidiAllocator *allocator;
+	      Result result;
+
+	      if (strcmp(alloc_name, "all") != 0
+		  && strcmp(alloc_name, alloc_names[i]) != 0)
+		continue;
+
+	      /* The conversions do not allocate, so one is enough */
+	      if (timed && !api->uses_context)
+		break;
+	      timed = TRUE;
+
+	      if (i == 0)
+		allocator = &fribidi_allocator_glib;
+	      else if (i == 1)
+		allocator = &fribidi_allocator_malloc;
+	      else
+		allocator = fribidi_allocator_arena_new(0);
+
+	      run_benchmark(api, &b, allocator, niter, min_time_ms * 1e6,
+			    warmup, reps, &result);
+
+	      if (i == 2)
+		fribidi_allocator_arena_destroy(allocator);
+
+	      /* output result */
+	      if (do_csv)
+		printf("%s,%d,%s,%s,%d,%d,%.3f,%.3f,%.0f,%lu",
+		       corpus->name, b.len, api->name,
+		       api->uses_context ? alloc_names[i] : "",
+		       result.niter, reps, result.median_ns, result.min_ns,
+		       1e9 / result.median_ns,
+		       (unsigned long)result.peak_bytes);
+	      else
+		printf("%-16s %8d %-16s %-6s %10.3f %10.3f %14.0f %10lu\n",
+		       corpus->name, b.len, api->name,
+		       api->uses_context ? alloc_names[i] : "-",
+		       result.median_ns, result.min_ns,
+		       1e9 / result.median_ns,
+		       (unsigned long)result.peak_bytes);
+	      if (do_stats)
+		print_stats(&result, reps, b.len, do_csv);
+	      else if (do_csv)
+		printf("\n");
+	      fflush(stdout);
+	    }
+	}
+
+      bench_free(&b);
+    }
+
   return 0;
 }
@@ -0,0 +1,104 @@
+/* FriBidi - Library of BiDi algorithm
+ * Copyright (C) 1999 Dov Grobgeld
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*======================================================================
+//  The binary output of "fribidi -binary". The results of each line
+//  are laid out so that a reader can map the file into memory and use
+//  them in place. All numbers are in the byte order of the machine
+//  that wrote the file, which the byte_order field of the header
+//  tells.
+//
+//  The file is a FriBidiBinaryHeader followed by a record for each
+//  line of the input:
+//
+//    FriBidiBinaryLine                 16 bytes
+//    guint16 position_L_to_V[len]
+//    guint16 position_V_to_L[len]
+//    guchar  text[text_bytes]          The visual text, in the
+//                                      character set of the header
+//    padding to a multiple of 4
+//    FriBidiBinaryLevelRun level_runs[num_level_runs]
+//    padding to a multiple of 8
+//
+//  Every record starts at a multiple of 8 bytes from the start of the
+//  file. The library takes at most FRIBIDI_MAX_STRING_LENGTH characters
+//  at a time, so a longer line is written as several records, all but
+//  the last of which have FRIBIDI_BINARY_CONTINUED set.
+//----------------------------------------------------------------------*/
+#ifndef FRIBIDI_BINARY_H
+#define FRIBIDI_BINARY_H
+
+#include "fribidi_types.h"
+
+#define FRIBIDI_BINARY_MAGIC "FBDB"
+#define FRIBIDI_BINARY_VERSION 1
+#define FRIBIDI_BINARY_BYTE_ORDER 0x0102
+
+/* The line goes on in the next record */
+#define FRIBIDI_BINARY_CONTINUED 1
+
+typedef struct {
+  guint8 magic[4];              /* FRIBIDI_BINARY_MAGIC */
+  guint16 version;              /* FRIBIDI_BINARY_VERSION */
+  guint16 byte_order;           /* FRIBIDI_BINARY_BYTE_ORDER as written */
+  gint32 char_set;              /* FRIBIDI_CHARSET_*, or 0 for CapRTL */
+  guint32 reserved;
+} FriBidiBinaryHeader;
+
+typedef struct {
+  guint32 record_size;          /* In bytes, this structure included */
+  guint32 len;                  /* In characters */
+  guint32 text_bytes;
+  guint16 num_level_runs;
+  guint8 base_level;            /* 0 left to right, 1 right to left */
+  guint8 flags;                 /* FRIBIDI_BINARY_CONTINUED */
+} FriBidiBinaryLine;
+
+/* A run of characters with the same level, in logical order */
+typedef struct {
+  guint16 length;
+  guint8 level;
+  guint8 reserved;
+} FriBidiBinaryLevelRun;
+
+/* Accessors of a record and of the record after it */
+#define FRIBIDI_BINARY_FIRST_LINE(header) \
+  ((const FriBidiBinaryLine *)((const FriBidiBinaryHeader *)(header) + 1))
+#define FRIBIDI_BINARY_L_TO_V(line) \
+  ((const guint16 *)((const FriBidiBinaryLine *)(line) + 1))
+#define FRIBIDI_BINARY_V_TO_L(line) \
+  (FRIBIDI_BINARY_L_TO_V(line) + (line)->len)
+#define FRIBIDI_BINARY_TEXT(line) \
+  ((const guchar *)(FRIBIDI_BINARY_V_TO_L(line) + (line)->len))
+#define FRIBIDI_BINARY_LEVEL_RUNS(line) \
+  ((const FriBidiBinaryLevelRun *) \
+   (FRIBIDI_BINARY_TEXT(line) + FRIBIDI_BINARY_ALIGN((line)->text_bytes, 4)))
+#define FRIBIDI_BINARY_NEXT_LINE(line) \
+  ((const FriBidiBinaryLine *) \
+   ((const guint8 *)(line) + (line)->record_size))
+
+#define FRIBIDI_BINARY_ALIGN(n, a) (((n) + (a) - 1) & ~((gsize)(a) - 1))
+
+/* The size of the record of a line, before its level runs are known */
+#define FRIBIDI_BINARY_MAX_RECORD_SIZE(len, text_bytes) \
+  (sizeof(FriBidiBinaryLine) + 4 * (gsize)(len) \
+   + FRIBIDI_BINARY_ALIGN((text_bytes), 4) \
+   + sizeof(FriBidiBinaryLevelRun) * (gsize)(len) + 8)
+
+#endif /* FRIBIDI_BINARY_H */
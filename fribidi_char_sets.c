@@ -16,552 +16,668 @@
  * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
  * Boston, MA 02111-1307, USA.
  */
-#include "fribidi.h"
-
-#define ISO_ALEF 224
-#define ISO_TAV 250
-
-/* The following are proposed extensions to iso-8859-8. */
-#define ISO_8859_8_LRM 253
-#define ISO_8859_8_RLM 254
-#define ISO_8859_8_LRE 251
-#define ISO_8859_8_RLE 252
-#define ISO_8859_8_PDF 221
-#define ISO_8859_8_LRO 219
-#define ISO_8859_8_RLO 220
-
-#define UNI_ALEF 0x05D0
-#define UNI_TAV 0x05EA
-#define UNI_LRM 0x200E
-#define UNI_RLM 0x200F
-#define UNI_LRE 0x202a
-#define UNI_RLE 0x202b
-#define UNI_PDF 0x202c
-#define UNI_LRO 0x202d
-#define UNI_RLO 0x202e
-
-#define CP1255_SHEVA 0xC0
-#define UNI_SHEVA 0x05B0
-#define CP1255_SOF_PASUQ 0xD3
-#define UNI_SOF_PASUQ 0x05C3
-#define CP1255_DOUBLE_VAV 0xD4
-#define UNI_DOUBLE_VAV 0x05F0
-#define CP1255_GERSHAYIM 0xD8
-#define UNI_GERSHAYIM 0x05F4
-
-#define ISO_HAMZA 0xc1
-#define ISO_SUKUN 0xf2
-#define UNI_HAMZA 0x0621
-#define UNI_SUKUN 0x0652
-
-#define CP1256_DAD 0xD6
-#define UNI_DAD 0x0636
+#include <string.h>
+#include "fribidi_private.h"
+#include "fribidi_char_sets.h"
+
+/*======================================================================
+//  The 8-bit character sets are converted through the tables that
+//  CreateCharSetTables.pl writes to fribidi_char_sets_tables.i: a
+//  table of 256 characters to Unicode, and a two level table from
+//  Unicode. Whole strings are converted by the kernels in
+//  fribidi_simd.c.
+//----------------------------------------------------------------------*/
+#include "fribidi_char_sets_tables.i"
+
+#define TO_UNICODE(cs, ch) (fribidi_##cs##_to_unicode_table[(guchar)(ch)])
+
+/* Page 0 of every set maps everything to the unknown character, '' */
+#define FROM_UNICODE(cs, uch)						\
+  ((uch) < 0x10000							\
+   ? fribidi_unicode_to_##cs##_pages[fribidi_unicode_to_##cs##_index[(uch) >> 8] \
+				     + ((uch) & 0xFF)]			\
+   : fribidi_unicode_to_##cs##_pages[0])
+
+#define STRING_TO_UNICODE(cs, s, us)					\
+  fribidi_8bit_to_unicode(fribidi_##cs##_to_unicode_table,		\
+			  (s), strlen(s) + 1, (us))
+
+#define STRING_FROM_UNICODE(cs, us, length, s)				\
+  fribidi_unicode_to_8bit(fribidi_unicode_to_##cs##_index,		\
+			  fribidi_unicode_to_##cs##_pages,		\
+			  (us), (length), (s))
 
 FriBidiChar
-fribidi_iso8859_8_to_unicode_c(guchar ch)
+fribidi_iso8859_6_to_unicode_c(guchar ch)
 {
-  /* optimization */
-  if (ch < ISO_8859_8_LRO)
-    return ch;
-  else if (ch >= ISO_ALEF && ch <= ISO_TAV)
-    return ch-ISO_ALEF+UNI_ALEF;
-  switch(ch)
-    {
-    case ISO_8859_8_RLM: return UNI_RLM;
-    case ISO_8859_8_LRM: return UNI_LRM;
-    case ISO_8859_8_RLO: return UNI_RLO;
-    case ISO_8859_8_LRO: return UNI_LRO;
-    case ISO_8859_8_RLE: return UNI_RLE;
-    case ISO_8859_8_LRE: return UNI_LRE;
-    case ISO_8859_8_PDF: return UNI_PDF;
-    default:
-      return '?';      /* This shouldn't happen! */
-    }
+  return TO_UNICODE(iso8859_6, ch);
 }
 
 guchar
-fribidi_unicode_to_iso8859_8_c(FriBidiChar uch)
+fribidi_unicode_to_iso8859_6_c(FriBidiChar uch)
 {
-  if (uch<128)
-    return uch;
-  if (uch >= UNI_ALEF && uch <= UNI_TAV)
-    return (guchar)(uch-UNI_ALEF+ISO_ALEF);
-  switch (uch) {
-    case UNI_RLM: return ISO_8859_8_RLM;
-    case UNI_LRM: return ISO_8859_8_LRM;
-    case UNI_RLO: return ISO_8859_8_RLO;
-    case UNI_LRO: return ISO_8859_8_LRO;
-    case UNI_RLE: return ISO_8859_8_RLE;
-    case UNI_LRE: return ISO_8859_8_LRE;
-    case UNI_PDF: return ISO_8859_8_PDF;
-  }
-  return '';
+  return FROM_UNICODE(iso8859_6, uch);
 }
 
 FriBidiChar
-fribidi_iso8859_6_to_unicode_c(guchar ch)
+fribidi_iso8859_8_to_unicode_c(guchar ch)
 {
-  if (ch >= ISO_HAMZA && ch <= ISO_SUKUN)
-    return ch-ISO_HAMZA+UNI_HAMZA;
-  else
-    return ch;
+  return TO_UNICODE(iso8859_8, ch);
 }
 
-FriBidiChar
-fribidi_cp1255_to_unicode_tab[] = { /* 0x80-0xBF */
-	0x20AC,  0x81,0x201A,0x0192,0x201E,0x2026,0x2020,0x2021,
-	0x02C6,0x2030,  0x8a,0x2039,  0x8c,  0x8d,  0x8e,  0x8f,
-	  0x90,0x2018,0x2019,0x201C,0x201D,0x2022,0x2013,0x2014,
-	0x02DC,0x2122,  0x9a,0x203A,  0x9c,  0x9d,  0x9e,  0x9f,
-	0x00A0,0x00A1,0x00A2,0x00A3,0x20AA,0x00A5,0x00A6,0x00A7,
-	0x00A8,0x00A9,0x00D7,0x00AB,0x00AC,0x00AD,0x00AE,0x00AF,
-	0x00B0,0x00B1,0x00B2,0x00B3,0x00B4,0x00B5,0x00B6,0x00B7,
-	0x00B8,0x00B9,0x00F7,0x00BB,0x00BC,0x00BD,0x00BE,0x00BF
-};
+guchar
+fribidi_unicode_to_iso8859_8_c(FriBidiChar uch)
+{
+  return FROM_UNICODE(iso8859_8, uch);
+}
 
 FriBidiChar
 fribidi_cp1255_to_unicode_c(guchar ch)
 {
-  if (ch >= ISO_ALEF && ch <= ISO_TAV)
-    return ch-ISO_ALEF+UNI_ALEF;
-  else if (ch >= CP1255_SHEVA && ch <= CP1255_SOF_PASUQ)
-    return ch-CP1255_SHEVA+UNI_SHEVA;
-  else if (ch >= CP1255_DOUBLE_VAV && ch <= CP1255_GERSHAYIM)
-    return ch-CP1255_DOUBLE_VAV+UNI_DOUBLE_VAV;
-  /* cp1256 specific chars */
-  else if (ch >= 0x80 && ch <= 0xbf)
-    return fribidi_cp1255_to_unicode_tab[ch-0x80];	 
-  else
-    return ch;
+  return TO_UNICODE(cp1255, ch);
 }
 
-FriBidiChar
-fribidi_cp1256_to_unicode_tab[] = { /* 0x80-0xFF */
-	0x20AC,0x067E,0x201A,0x0192,0x201E,0x2026,0x2020,0x2021,
-	0x02C6,0x2030,0x0679,0x2039,0x0152,0x0686,0x0698,0x0688,
-	0x06AF,0x2018,0x2019,0x201C,0x201D,0x2022,0x2013,0x2014,
-	0x06A9,0x2122,0x0691,0x203A,0x0153,0x200C,0x200D,0x06BA,
-	0x00A0,0x060C,0x00A2,0x00A3,0x00A4,0x00A5,0x00A6,0x00A7,
-	0x00A8,0x00A9,0x06BE,0x00AB,0x00AC,0x00AD,0x00AE,0x00AF,
-	0x00B0,0x00B1,0x00B2,0x00B3,0x00B4,0x00B5,0x00B6,0x00B7,
-	0x00B8,0x00B9,0x061B,0x00BB,0x00BC,0x00BD,0x00BE,0x061F,
-	0x06C1,0x0621,0x0622,0x0623,0x0624,0x0625,0x0626,0x0627,
-	0x0628,0x0629,0x062A,0x062B,0x062C,0x062D,0x062E,0x062F,
-	0x0630,0x0631,0x0632,0x0633,0x0634,0x0635,0x0636,0x00D7,
-	0x0637,0x0638,0x0639,0x063A,0x0640,0x0641,0x0642,0x0643,
-	0x00E0,0x0644,0x00E2,0x0645,0x0646,0x0647,0x0648,0x00E7,
-	0x00E8,0x00E9,0x00EA,0x00EB,0x0649,0x064A,0x00EE,0x00EF,
-	0x064B,0x064C,0x064D,0x064E,0x00F4,0x064F,0x0650,0x00F7,
-	0x0651,0x00F9,0x0652,0x00FB,0x00FC,0x200E,0x200F,0x00ff
-};
+guchar
+fribidi_unicode_to_cp1255_c(FriBidiChar uch)
+{
+  return FROM_UNICODE(cp1255, uch);
+}
 
 FriBidiChar
 fribidi_cp1256_to_unicode_c(guchar ch)
 {
-  if (ch >= 0x80 && ch <= 0xff) 
-    return fribidi_cp1256_to_unicode_tab[ch-0x80];
-  else
-    return ch;
+  return TO_UNICODE(cp1256, ch);
 }
 
-FriBidiChar
-fribidi_isiri_3342_to_unicode_tab[] = { /* 0xA0-0xFF */
-	0x0020,0x200C,0x200D,0x0021,0x00A4,0x066A,0x002E,0x066C,
-	0x0029,0x0028,0x00D7,0x002B,0x060C,0x002D,0x066B,0x002F,
-	0x06F0,0x06F1,0x06F2,0x06F3,0x06F4,0x06F5,0x06F6,0x06F7,
-	0x06F8,0x06F9,0x003A,0x061B,0x003C,0x003D,0x003E,0x061F,
-	0x0622,0x0627,0x0621,0x0628,0x067E,0x062A,0x062B,0x062C,
-	0x0686,0x062D,0x062E,0x062F,0x0630,0x0631,0x0632,0x0698,
-	0x0633,0x0634,0x0635,0x0636,0x0637,0x0638,0x0639,0x063A,
-	0x0641,0x0642,0x06A9,0x06AF,0x0644,0x0645,0x0646,0x0648,
-	0x0647,0x06CC,0x005D,0x005B,0x007D,0x007B,0x00AB,0x00BB,
-	/* 0xec,0xed,0xee,0xef not defined */
-	0x002A,0x0640,0x007C,0x005C,0xec  ,0xed  ,0xee  ,0xef  ,
-	0x064E,0x0650,0x064F,0x064B,0x064D,0x064C,0x0651,0x0652,
-	0x0623,0x0624,0x0625,0x0626,0x0629,0x0643,0x064A,0x007F
-};
+guchar
+fribidi_unicode_to_cp1256_c(FriBidiChar uch)
+{
+  return FROM_UNICODE(cp1256, uch);
+}
 
 FriBidiChar
 fribidi_isiri_3342_to_unicode_c(guchar ch)
 {
-  if ((ch >= 0x80 && ch <= 0xa0) || ch == 0xff)
-    return ch-0x80; /* FIXME: but they are strong typed RTL ! */
-  else if (ch >= 0xa1 && ch <= 0xfe)
-    return fribidi_isiri_3342_to_unicode_tab[ch-0xa0]; 
-  /* TODO */
-  else
-    return ch;
+  return TO_UNICODE(isiri_3342, ch);
+}
+
+guchar
+fribidi_unicode_to_isiri_3342_c(FriBidiChar uch)
+{
+  return FROM_UNICODE(isiri_3342, uch);
 }
 
 void
 fribidi_iso8859_6_to_unicode(guchar *s,
 			     FriBidiChar *us)
 {
-  int i;
-  int len = strlen(s);
-  
-  for (i=0; i<len+1; i++)
-    us[i] = fribidi_iso8859_6_to_unicode_c(s[i]);
+  STRING_TO_UNICODE(iso8859_6, s, us);
 }
 
 void
 fribidi_iso8859_8_to_unicode(guchar *s,
 			     FriBidiChar *us)
 {
-  int i;
-  int len = strlen(s);
-  
-  for (i=0; i<len+1; i++)
-    us[i] = fribidi_iso8859_8_to_unicode_c(s[i]);
+  STRING_TO_UNICODE(iso8859_8, s, us);
 }
 
 void
 fribidi_cp1255_to_unicode(guchar *s,
 			  FriBidiChar *us)
 {
-  int i;
-  int len = strlen(s);
-  
-  for (i=0; i<len+1; i++)
-    us[i] = fribidi_cp1255_to_unicode_c(s[i]);
+  STRING_TO_UNICODE(cp1255, s, us);
 }
 
 void
 fribidi_cp1256_to_unicode(guchar *s,
 			  FriBidiChar *us)
 {
-  int i;
-  int len = strlen(s);
-  
-  for (i=0; i<len+1; i++)
-    us[i] = fribidi_cp1256_to_unicode_c(s[i]);
+  STRING_TO_UNICODE(cp1256, s, us);
 }
 
 void
 fribidi_isiri_3342_to_unicode(guchar *s,
 			      FriBidiChar *us)
 {
-  int i;
-  int len = strlen(s);
-  
-  for (i=0; i<len+1; i++)
-    us[i] = fribidi_isiri_3342_to_unicode_c(s[i]);
-}
-
-guchar
-fribidi_unicode_to_iso8859_6_c(FriBidiChar uch)
-{
-  if (uch >= UNI_HAMZA && uch <= UNI_SUKUN)
-    return (guchar)(uch-UNI_HAMZA+ISO_HAMZA);
-  /* TODO: handle pre-composed and presentation chars */
-  else if (uch < 256)
-    return (guchar)uch;
-  else if (uch == 0x060c)
-    return (guchar)0xac;	
-  else if (uch == 0x061b)
-    return (guchar)0xbb;
-  else if (uch == 0x061f)
-    return (guchar)0xbf; 
-  else
-    return '';
-}
-
-
-guchar
-fribidi_unicode_to_cp1255_c(FriBidiChar uch)
-{
-  if (uch >= UNI_ALEF && uch <= UNI_TAV)
-    return (guchar)(uch-UNI_ALEF+ISO_ALEF);
-  if (uch >= UNI_SHEVA && uch <= UNI_SOF_PASUQ)
-    return (guchar)(uch-UNI_SHEVA+CP1255_SHEVA);
-  if (uch >= UNI_DOUBLE_VAV && uch <= UNI_GERSHAYIM)
-    return (guchar)(uch-UNI_DOUBLE_VAV+CP1255_DOUBLE_VAV);
-  /* TODO: handle pre-composed and presentation chars */
-  else if (uch < 256)
-    return (guchar)uch;
-  else
-    return '';
-}
-
-guchar
-fribidi_unicode_to_cp1256_c(FriBidiChar uch)
-{
-  if (uch < 256)
-    return (guchar)uch;
-  if (uch >= UNI_HAMZA && uch <= UNI_DAD)
-    return (guchar)(uch-UNI_HAMZA+ISO_HAMZA);
-  else switch (uch) {
-	case 0x0152: return 0x8c;
-	case 0x0153: return 0x9c;
-	case 0x0192: return 0x83;
-	case 0x02C6: return 0x88;
-	case 0x060C: return 0xA1;
-	case 0x061B: return 0xBA;
-	case 0x061F: return 0xBF;
-        case 0x0637: return 0xD8;
-	case 0x0638: return 0xD9;
-        case 0x0639: return 0xDA;
-	case 0x063A: return 0xDB; 
-	case 0x0640: return 0xDC;
-	case 0x0641: return 0xDD;
-	case 0x0642: return 0xDE;
-	case 0x0643: return 0xDF;
-	case 0x0644: return 0xE1;
-	case 0x0645: return 0xE3;
-	case 0x0646: return 0xE4;
-	case 0x0647: return 0xE5;
-	case 0x0648: return 0xE6;
-	case 0x0649: return 0xEC;
-	case 0x064A: return 0xED;
-	case 0x064B: return 0xF0;
-	case 0x064C: return 0xF1;
-	case 0x064D: return 0xF2;
-	case 0x064E: return 0xF3;
-	case 0x064F: return 0xF5;
-	case 0x0650: return 0xF6;
-	case 0x0651: return 0xF8;
-	case 0x0652: return 0xFA;
-	case 0x0679: return 0x8A;
-	case 0x067E: return 0x81;
-	case 0x0686: return 0x8D;
-	case 0x0688: return 0x8F;
-	case 0x0691: return 0x9A;
-	case 0x0698: return 0x8E;
-	case 0x06A9: return 0x98;
-	case 0x06AF: return 0x90;
-	case 0x06BA: return 0x9F;
-	case 0x06BE: return 0xAA;
-	case 0x06C1: return 0xC0;
-	case 0x200C: return 0x9D;
-	case 0x200D: return 0x9E;
-	case 0x200E: return 0xFD;
-	case 0x200F: return 0xFE;
-	case 0x2013: return 0x96;
-	case 0x2014: return 0x97;
-	case 0x2018: return 0x91;
-	case 0x2019: return 0x92;
-	case 0x201A: return 0x82;
-	case 0x201C: return 0x93;
-	case 0x201D: return 0x94;
-	case 0x201E: return 0x84;
-	case 0x2020: return 0x86;
-	case 0x2021: return 0x87;
-	case 0x2022: return 0x95;
-	case 0x2026: return 0x85;
-	case 0x2030: return 0x89;
-	case 0x2039: return 0x8B;
-	case 0x203A: return 0x9B;
-	case 0x20AC: return 0x80;
-	case 0x2122: return 0x99;
-
-	default: return '';
-  }	  
-}
-
-guchar
-fribidi_unicode_to_isiri_3342_c(FriBidiChar uch)
-{
-  /* TODO */
-  if (uch < 256)
-    return (guchar)uch;
-  else switch (uch) {
-	case 0x060C: return 0xAC;
-	case 0x061B: return 0xBB;
-	case 0x061F: return 0xBF;
-	case 0x0621: return 0xC2;
-	case 0x0622: return 0xC0;
-	case 0x0623: return 0xF8;
-	case 0x0624: return 0xF9;
-	case 0x0625: return 0xFA;
-	case 0x0626: return 0xFB;
-	case 0x0627: return 0xC1;
-	case 0x0628: return 0xC3;
-	case 0x0629: return 0xFC;
-	case 0x062A: return 0xC5;
-	case 0x062B: return 0xC6;
-	case 0x062C: return 0xC7;
-	case 0x062D: return 0xC9;
-	case 0x062E: return 0xCA;
-	case 0x062F: return 0xCB;
-	case 0x0630: return 0xCC;
-	case 0x0631: return 0xCD;
-	case 0x0632: return 0xCE;
-	case 0x0633: return 0xD0;
-	case 0x0634: return 0xD1;
-	case 0x0635: return 0xD2;
-	case 0x0636: return 0xD3;
-	case 0x0637: return 0xD4;
-	case 0x0638: return 0xD5;
-	case 0x0639: return 0xD6;
-	case 0x063A: return 0xD7;
-	case 0x0640: return 0xE9;
-	case 0x0641: return 0xD8;
-	case 0x0642: return 0xD9;
-	case 0x0643: return 0xFD;
-	case 0x0644: return 0xDC;
-	case 0x0645: return 0xDD;
-	case 0x0646: return 0xDE;
-	case 0x0647: return 0xE0;
-	case 0x0648: return 0xDF;
-	case 0x064A: return 0xFE;
-	case 0x064B: return 0xF3;
-	case 0x064C: return 0xF5;
-	case 0x064D: return 0xF4;
-	case 0x064E: return 0xF0;
-	case 0x064F: return 0xF2;
-	case 0x0650: return 0xF1;
-	case 0x0651: return 0xF6;
-	case 0x0652: return 0xF7;
-	case 0x066A: return 0xA5;
-	case 0x066B: return 0xAE;
-	case 0x066C: return 0xA7;
-	case 0x067E: return 0xC4;
-	case 0x0686: return 0xC8;
-	case 0x0698: return 0xCF;
-	case 0x06A9: return 0xDA;
-	case 0x06AF: return 0xDB;
-	case 0x06CC: return 0xE1;
-	case 0x06F0: return 0xB0;
-	case 0x06F1: return 0xB1;
-	case 0x06F2: return 0xB2;
-	case 0x06F3: return 0xB3;
-	case 0x06F4: return 0xB4;
-	case 0x06F5: return 0xB5;
-	case 0x06F6: return 0xB6;
-	case 0x06F7: return 0xB7;
-	case 0x06F8: return 0xB8;
-	case 0x06F9: return 0xB9;
-	case 0x200C: return 0xA1;
-	case 0x200D: return 0xA2;
-	default: return '';
-  }
+  STRING_TO_UNICODE(isiri_3342, s, us);
 }
 
 void
 fribidi_unicode_to_iso8859_6(FriBidiChar *us,
 			     int length,
 			     guchar *s)
-		     
 {
-  int i;
-  
-  for (i=0; i< length; i++)
-    s[i] = fribidi_unicode_to_iso8859_6_c(us[i]);
-  s[i] = 0;
+  STRING_FROM_UNICODE(iso8859_6, us, length, s);
+  s[length] = 0;
 }
 
 void
 fribidi_unicode_to_iso8859_8(FriBidiChar *us,
 			     int length,
 			     guchar *s)
-		     
 {
-  int i;
-  
-  for (i=0; i< length; i++)
-    s[i] = fribidi_unicode_to_iso8859_8_c(us[i]);
-  s[i] = 0;
+  STRING_FROM_UNICODE(iso8859_8, us, length, s);
+  s[length] = 0;
 }
 
 void
 fribidi_unicode_to_cp1255(FriBidiChar *us,
-			     int length,
-			     guchar *s)
-		     
+			  int length,
+			  guchar *s)
 {
-  int i;
-  
-  for (i=0; i< length; i++)
-    s[i] = fribidi_unicode_to_cp1255_c(us[i]);
-  s[i] = 0;
+  STRING_FROM_UNICODE(cp1255, us, length, s);
+  s[length] = 0;
 }
 
 void
 fribidi_unicode_to_cp1256(FriBidiChar *us,
-			     int length,
-			     guchar *s)
-		     
+			  int length,
+			  guchar *s)
 {
-  int i;
-  
-  for (i=0; i< length; i++)
-    s[i] = fribidi_unicode_to_cp1256_c(us[i]);
-  s[i] = 0;
+  STRING_FROM_UNICODE(cp1256, us, length, s);
+  s[length] = 0;
 }
 
 void
 fribidi_unicode_to_isiri_3342(FriBidiChar *us,
-			     int length,
-			     guchar *s)
-		     
+			      int length,
+			      guchar *s)
+{
+  STRING_FROM_UNICODE(isiri_3342, us, length, s);
+  s[length] = 0;
+}
+
+/*======================================================================
+//  The bidi tables of the 8-bit character sets, for running the
+//  algorithm directly on their bytes: the type and the mirror of each
+//  byte. They are built from the Unicode properties on first use.
+//
+//  In ISIRI 3342 the upper half repeats the ASCII punctuation, digits
+//  and space as strong right-to-left characters. Their Unicode
+//  counterparts are neutral, so these bytes are typed RTL here, and
+//  are mirrored within the upper half.
+//----------------------------------------------------------------------*/
+typedef struct {
+  FriBidiCharType types[256];
+  guchar mirrors[256];
+} CharSetBidiTables;
+
+enum {
+  BIDI_ISO8859_6,
+  BIDI_ISO8859_8,
+  BIDI_CP1255,
+  BIDI_CP1256,
+  BIDI_ISIRI_3342,
+  NUM_BIDI_TABLES
+};
+
+static CharSetBidiTables *bidi_tables[NUM_BIDI_TABLES];
+
+/* A table is built apart on first use and published at once, so that
+   a published table is never written again. Of threads that race to
+   build one, the first to publish wins and the others free theirs. */
+#ifdef __GNUC__
+#define TABLES_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define TABLES_PUBLISH(p, expected, t) \
+  __atomic_compare_exchange_n((p), (expected), (t), FALSE, \
+			      __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+#define TABLES_LOAD(p) (*(CharSetBidiTables * volatile *)(p))
+#define TABLES_PUBLISH(p, expected, t) (*(p) = (t), TRUE)
+#endif
+
+static void
+build_bidi_tables(CharSetBidiTables *tables,
+		  const FriBidiChar *to_unicode,
+		  gboolean ascii_copies_are_rtl)
+{
+  gint b, m;
+
+  for (b=0; b<256; b++)
+    {
+      FriBidiChar uch = to_unicode[b], mirrored_ch;
+      gboolean upper = b >= 0x80;
+
+      if (ascii_copies_are_rtl && upper && uch >= 0x20 && uch < 0x7F)
+	tables->types[b] = FRIBIDI_TYPE_RTL;
+      else
+	tables->types[b] = fribidi_get_type(uch);
+
+      /* Prefer a mirror in the same half of the set */
+      tables->mirrors[b] = b;
+      if (fribidi_get_mirror_char(uch, &mirrored_ch))
+	for (m=0; m<256; m++)
+	  if (to_unicode[m] == mirrored_ch)
+	    {
+	      tables->mirrors[b] = m;
+	      if ((m >= 0x80) == upper)
+		break;
+	    }
+    }
+}
+
+static CharSetBidiTables *
+get_bidi_tables(gint char_set)
 {
-  int i;
-  
-  for (i=0; i< length; i++)
-    s[i] = fribidi_unicode_to_isiri_3342_c(us[i]);
-  s[i] = 0;
+  const FriBidiChar *to_unicode;
+  CharSetBidiTables *tables;
+  gint idx;
+
+  switch (char_set)
+    {
+    case FRIBIDI_CHARSET_8859_6:
+      idx = BIDI_ISO8859_6;
+      to_unicode = fribidi_iso8859_6_to_unicode_table;
+      break;
+    case FRIBIDI_CHARSET_8859_8:
+      idx = BIDI_ISO8859_8;
+      to_unicode = fribidi_iso8859_8_to_unicode_table;
+      break;
+    case FRIBIDI_CHARSET_CP1255:
+      idx = BIDI_CP1255;
+      to_unicode = fribidi_cp1255_to_unicode_table;
+      break;
+    case FRIBIDI_CHARSET_CP1256:
+      idx = BIDI_CP1256;
+      to_unicode = fribidi_cp1256_to_unicode_table;
+      break;
+    case FRIBIDI_CHARSET_ISIRI_3342:
+      idx = BIDI_ISIRI_3342;
+      to_unicode = fribidi_isiri_3342_to_unicode_table;
+      break;
+    default:
+      return NULL;
+    }
+
+  tables = TABLES_LOAD(&bidi_tables[idx]);
+  if (!tables)
+    {
+      CharSetBidiTables *built = g_new(CharSetBidiTables, 1);
+
+      build_bidi_tables(built, to_unicode, idx == BIDI_ISIRI_3342);
+      if (TABLES_PUBLISH(&bidi_tables[idx], &tables, built))
+	tables = built;
+      else
+	g_free(built);
+    }
+  return tables;
+}
+
+/*======================================================================
+//  fribidi_log2vis_charset() runs the algorithm directly on text in
+//  one of the 8-bit character sets, and writes the visual string in
+//  the same set. It returns FALSE, and does nothing, for UTF-8 and
+//  for unknown sets.
+//----------------------------------------------------------------------*/
+gboolean
+fribidi_context_log2vis_charset(FriBidiContext *ctx,
+				gint char_set,
+				/* input */
+				guchar *str,
+				gint len,
+				FriBidiCharType *pbase_dir,
+				/* output */
+				guchar *visual_str,
+				guint16 *position_L_to_V_list,
+				guint16 *position_V_to_L_list,
+				guint8 *embedding_level_list)
+{
+  CharSetBidiTables *tables = get_bidi_tables(char_set);
+
+  if (!tables)
+    return FALSE;
+
+  fribidi_context_log2vis_8bit(ctx, tables->types, tables->mirrors,
+			       str, len, pbase_dir,
+			       visual_str,
+			       position_L_to_V_list,
+			       position_V_to_L_list,
+			       embedding_level_list);
+  return TRUE;
+}
+
+gboolean
+fribidi_log2vis_charset(gint char_set,
+			/* input */
+			guchar *str,
+			gint len,
+			FriBidiCharType *pbase_dir,
+			/* output */
+			guchar *visual_str,
+			guint16 *position_L_to_V_list,
+			guint16 *position_V_to_L_list,
+			guint8 *embedding_level_list)
+{
+  return fribidi_context_log2vis_charset(fribidi_default_context(),
+					 char_set, str, len, pbase_dir,
+					 visual_str,
+					 position_L_to_V_list,
+					 position_V_to_L_list,
+					 embedding_level_list);
 }
 
 /* the following added by Raphael Finkel <raphael@cs.uky.edu> 12/1999 */
 
+/*======================================================================
+//  UTF-8 encoding. Characters that have no UTF-8 form, surrogates and
+//  values beyond U+10FFFF, are encoded as U+FFFD. The blocks of ASCII
+//  and of two byte forms are left to the vector kernel, and the rest
+//  is encoded one character at a time.
+//----------------------------------------------------------------------*/
+static gint
+utf8_encode_char(FriBidiChar ch,
+		 /* Output */
+		 guchar *s)
+{
+  if (ch < 0x80)
+    {
+      s[0] = ch;
+      return 1;
+    }
+  if (ch < 0x800)
+    {
+      s[0] = 0xC0 | (ch >> 6);
+      s[1] = 0x80 | (ch & 0x3F);
+      return 2;
+    }
+  if (ch > 0x10FFFF || (ch >= 0xD800 && ch < 0xE000))
+    ch = 0xFFFD;
+  if (ch < 0x10000)
+    {
+      s[0] = 0xE0 | (ch >> 12);
+      s[1] = 0x80 | ((ch >> 6) & 0x3F);
+      s[2] = 0x80 | (ch & 0x3F);
+      return 3;
+    }
+  s[0] = 0xF0 | (ch >> 18);
+  s[1] = 0x80 | ((ch >> 12) & 0x3F);
+  s[2] = 0x80 | ((ch >> 6) & 0x3F);
+  s[3] = 0x80 | (ch & 0x3F);
+  return 4;
+}
+
+#define UTF8_CHAR_LENGTH(ch) \
+  (((ch) < 0x80) ? 1 : ((ch) < 0x800) ? 2 : ((ch) < 0x10000) ? 3 \
+   : ((ch) <= 0x10FFFF) ? 4 : 3)
+
+/* Characters that are encoded one at a time before the kernel is
+   tried again */
+#define UTF8_SCALAR_BLOCK 8
+
+static gint
+utf8_encode(FriBidiChar *us,
+	    gint len,
+	    guchar *s,
+	    gint size,
+	    /* Output */
+	    gint *consumed)
+{
+  gint i = 0, j = 0;
+
+  while (i < len)
+    {
+      gint stop;
+
+      if (us[i] < 0x800)
+	{
+	  gint bytes;
+	  gint n = fribidi_utf8_encode_prefix(us + i, len - i, s + j, size - j,
+					      &bytes);
+	  if (n > 0)
+	    {
+	      i += n;
+	      j += bytes;
+	      continue;
+	    }
+	}
+
+      stop = MIN(len, i + UTF8_SCALAR_BLOCK);
+      for (; i<stop; i++)
+	{
+	  if (j + UTF8_CHAR_LENGTH(us[i]) > size)
+	    goto done;
+	  j += utf8_encode_char(us[i], s + j);
+	}
+    }
+
+ done:
+  *consumed = i;
+  return j;
+}
+
+/*======================================================================
+//  fribidi_utf8_encoded_length() returns the number of bytes of the
+//  UTF-8 form of us, not counting a terminating zero, so that the
+//  output of fribidi_unicode_to_utf8() can be allocated exactly.
+//----------------------------------------------------------------------*/
+gint
+fribidi_utf8_encoded_length(FriBidiChar *us,
+			    gint length)
+{
+  return fribidi_utf8_count_bytes(us, length);
+}
+
 void
 fribidi_unicode_to_utf8(FriBidiChar *us,
                            int length,
                            guchar *s)
 /* warning: the length of output string may exceed the length of the input */
+/* s must have room for fribidi_utf8_encoded_length(us, length) + 1 bytes */
+{
+  gint consumed;
+  gint n = utf8_encode(us, length, s, G_MAXINT, &consumed);
+
+  s[n] = 0;
+}
+
+/*======================================================================
+//  fribidi_unicode_to_utf8_chunk() encodes as many whole characters of
+//  us as fit in the size bytes of s, without a terminating zero. It
+//  returns the number of bytes written and gives the number of
+//  characters in *consumed. A long string may be written out through
+//  a small buffer by calling it again from us + *consumed.
+//----------------------------------------------------------------------*/
+gint
+fribidi_unicode_to_utf8_chunk(FriBidiChar *us,
+			      gint length,
+			      guchar *s,
+			      gint size,
+			      /* Output */
+			      gint *consumed)
+{
+  return utf8_encode(us, length, s, size, consumed);
+}
 
+
+/*======================================================================
+//  fribidi_utf8_decode_char() decodes the character at the start of
+//  s, of which len bytes are left, and returns its length in bytes.
+//  It returns 0 if the bytes are not a well formed sequence: a stray
+//  continuation byte, a sequence cut short, an overlong form, a
+//  surrogate, or a character beyond U+10FFFF. It never reads more
+//  than len bytes.
+//----------------------------------------------------------------------*/
+#define UTF8_IS_CONT(b) (((b) & 0xC0) == 0x80)
+
+gint
+fribidi_utf8_decode_char(guchar *s,
+			 gint len,
+			 /* Output */
+			 FriBidiChar *ch)
+{
+  guchar b = s[0];
+
+  if (b < 0x80)
+    {
+      *ch = b;
+      return 1;
+    }
+  if (b >= 0xC2 && b <= 0xDF && len >= 2 && UTF8_IS_CONT(s[1]))
+    {
+      *ch = ((b & 0x1F) << 6) | (s[1] & 0x3F);
+      return 2;
+    }
+  if (b >= 0xE0 && b <= 0xEF && len >= 3
+      && UTF8_IS_CONT(s[1]) && UTF8_IS_CONT(s[2])
+      && !(b == 0xE0 && s[1] < 0xA0)          /* Overlong */
+      && !(b == 0xED && s[1] >= 0xA0))        /* Surrogate */
+    {
+      *ch = ((b & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+      return 3;
+    }
+  if (b >= 0xF0 && b <= 0xF4 && len >= 4
+      && UTF8_IS_CONT(s[1]) && UTF8_IS_CONT(s[2]) && UTF8_IS_CONT(s[3])
+      && !(b == 0xF0 && s[1] < 0x90)          /* Overlong */
+      && !(b == 0xF4 && s[1] >= 0x90))        /* Beyond U+10FFFF */
+    {
+      *ch = ((b & 0x07) << 18) | ((s[1] & 0x3F) << 12)
+	| ((s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+      return 4;
+    }
+  return 0;
+}
+
+/*======================================================================
+//  utf8_decode() decodes the bytes of s into us until len bytes or
+//  max_chars characters are done, or until a malformed sequence is
+//  found. It returns the number of characters and gives the number of
+//  bytes in *consumed. Runs of ASCII are widened by the vector kernel
+//  a block at a time, as long as a whole block is left. The kernel
+//  stops at a block with a byte above 0x7F, so it is not asked again
+//  until that block is behind; the ASCII bytes in between are copied
+//  one at a time.
+//----------------------------------------------------------------------*/
+static gint
+utf8_decode(guchar *s,
+	    gint len,
+	    FriBidiChar *us,
+	    gint max_chars,
+	    /* Output */
+	    gint *consumed)
 {
-  int i;
+  FriBidiAsciiPrefixFunc ascii_prefix = fribidi_utf8_ascii_prefix_kernel();
+  gint i = 0, n = 0, vector_from = 0;
 
-  for (i=0; i< length; i++)
+  while (i < len && n < max_chars)
     {
-      FriBidiChar mychar = us[i];
-      if (mychar <= 0x7F) { /* 7 sig bits; plain 7-bit ascii */
-	*s++ = mychar;
-      } else if (mychar <= 0x7FF) /* 11 sig bits; Hebrew is in this range */
+      gint ch_len;
+
+      if (s[i] < 0x80)
 	{
-	  *s++ = 0300 | (guint8) ((mychar >> 6)&037);
-	  *s++ = 0200 | (guint8) (mychar & 077); /* lower 6 bits */
-	} else if (mychar <= 0xFFFF) { /* 16 sig bits */
-	  *s++ = 0340 | (guint8) ((mychar >> 12)&017), /* upper 4 bits */
-	  *s++ = 0200 | (guint8) ((mychar >> 6)&077),  /* next 6 bits */
-	  *s++ = 0200 | (guint8) (mychar & 077);       /* lowest 6 bits */
+	  if (ascii_prefix && i >= vector_from
+	      && len - i >= FRIBIDI_UTF8_ASCII_BLOCK
+	      && max_chars - n >= FRIBIDI_UTF8_ASCII_BLOCK)
+	    {
+	      gint ascii = ascii_prefix(s + i, MIN(len - i, max_chars - n),
+					us + n);
+	      i += ascii;
+	      n += ascii;
+	      vector_from = i + FRIBIDI_UTF8_ASCII_BLOCK;
+	      if (ascii > 0)
+		continue;
+	    }
+	  us[n++] = s[i++];
+	  continue;
 	}
+
+      ch_len = fribidi_utf8_decode_char(s + i, len - i, us + n);
+      if (ch_len == 0)
+	break;
+      i += ch_len;
+      n++;
     }
-  *s = 0;
-}
 
+  *consumed = i;
+  return n;
+}
 
 int /* we return the length */
 fribidi_utf8_to_unicode(guchar *s,
 			FriBidiChar *us)
 /* warning: the length of input string may exceed the length of the output */
+/* Malformed sequences are decoded as one U+FFFD for each byte. */
 {
-  int length;
-  
-  length = 0;
-  while (*s) {
-    if (*s <= 0177) /* one byte */
-      {
-	*us++ = *s++; /* expand with 0s */
-      }
-    else if (*s < 0340) /* 2 chars, such as Hebrew */
-      {
-	*us++ = ((*s & 037) << 6) + (*(s+1) & 077);
-	s += 2;
-      }
-    else /* 3 chars */
-      {
-	*us++ = ((*s & 017) << 12) + ((*(s+1) & 077) << 6) +
-	  (*(s+2) & 077);
-	s += 3;
-      }
-    length += 1;
-  }
-  *us = 0;
+  gint len = strlen((gchar *) s);
+  gint i = 0, length = 0;
+
+  while (i < len)
+    {
+      gint consumed;
+
+      length += utf8_decode(s + i, len - i, us + length, len - i, &consumed);
+      i += consumed;
+      if (i < len)
+	{
+	  us[length++] = 0xFFFD;
+	  i++;
+	}
+    }
+  us[length] = 0;
   return(length);
 }
 
+/*======================================================================
+//  fribidi_utf8_to_unicode_checked() decodes len bytes of UTF-8 into
+//  us, which must have room for len characters. It stops at the first
+//  malformed sequence and gives its offset in *error_pos, or -1 if the
+//  whole string is well formed. The number of characters decoded is
+//  returned.
+//----------------------------------------------------------------------*/
+gint
+fribidi_utf8_to_unicode_checked(guchar *s,
+				gint len,
+				/* Output */
+				FriBidiChar *us,
+				gint *error_pos)
+{
+  gint consumed;
+  gint length = utf8_decode(s, len, us, len, &consumed);
+
+  *error_pos = (consumed < len) ? consumed : -1;
+  return length;
+}
+
+/* fribidi_utf8_validate() only checks that s is well formed UTF-8 */
+gboolean
+fribidi_utf8_validate(guchar *s,
+		      gint len,
+		      /* Output */
+		      gint *error_pos)
+{
+  gint i = 0;
+
+  while (i < len)
+    {
+      FriBidiChar ch;
+      gint ch_len;
+
+      /* Skip ASCII a word at a time */
+      while (i + 8 <= len)
+	{
+	  guint64 word;
+	  memcpy(&word, s + i, 8);
+	  if (word & G_GINT64_CONSTANT(0x8080808080808080U))
+	    break;
+	  i += 8;
+	}
+      if (i == len)
+	break;
+
+      ch_len = fribidi_utf8_decode_char(s + i, len - i, &ch);
+      if (ch_len == 0)
+	{
+	  if (error_pos)
+	    *error_pos = i;
+	  return FALSE;
+	}
+      i += ch_len;
+    }
+
+  if (error_pos)
+    *error_pos = -1;
+  return TRUE;
+}
+
 /* the following was added by Omer Zak <omerz@actcom.co.il> Sept 2000.
 ** The following functions do the same thing, but have better-defined
 ** interfaces.
@@ -586,68 +702,20 @@ fribidi_unicode_to_utf8_p(FriBidiChar *in_unicode_str,  /* Unicode string */
 							** used in the UTF8 buffer.
 							*/
 {
-  guint l_utf8_buffer_fence;  /* Fence - 6 octets before end */
-  guint index;
-  guint index_utf8;
+  gint consumed;
+  gint bytes;
 
   if (NULL == in_unicode_str) return(FALSE);
   if (NULL == utf8_buffer) return(FALSE);
   if (NULL == out_uni_consumed_length_p) return(FALSE);
   if (NULL == out_actual_utf8_buffer_length_p) return(FALSE);
-  if (utf8_buffer_length < 6) return(FALSE);
-
-  /* If we are here, all outputs must have some valid values. */
-  *out_uni_consumed_length_p = 0;
-  *out_actual_utf8_buffer_length_p = 0;
-
-  l_utf8_buffer_fence = utf8_buffer_length-6;
-
-  for (index = 0, index_utf8 = 0; index < in_unicode_length; index++) {
-    FriBidiChar ucs4_char;
-
-    if (index_utf8 > l_utf8_buffer_fence) {
-      break;  /* No more guaranteed room in UTF8 buffer. */
-    }
-
-    ucs4_char = in_unicode_str[index];
-
-#define PUT_UTF8_BYTE(b) utf8_buffer[index_utf8] = (b); index_utf8++
-
-    if (ucs4_char <        0x00000080) {
-      PUT_UTF8_BYTE(ucs4_char &  0x0000007F);
-    } else if (ucs4_char < 0x00000800) {
-      PUT_UTF8_BYTE(((ucs4_char >> 6) & 0x0000001F) | 0x000000C0);
-      PUT_UTF8_BYTE((ucs4_char & 0x0000003F) | 0x00000080);
-    } else if (ucs4_char < 0x00010000) {
-      PUT_UTF8_BYTE(((ucs4_char >> 12) & 0x0000000F) | 0x000000E0);
-      PUT_UTF8_BYTE(((ucs4_char >> 6) & 0x0000003F) | 0x00000080);
-      PUT_UTF8_BYTE((ucs4_char & 0x0000003F) | 0x00000080);
-    } else if (ucs4_char < 0x00200000) {
-      PUT_UTF8_BYTE(((ucs4_char >> 18) & 0x00000007) | 0x000000F0);
-      PUT_UTF8_BYTE(((ucs4_char >> 12) & 0x0000003F) | 0x00000080);
-      PUT_UTF8_BYTE(((ucs4_char >> 6) & 0x0000003F) | 0x00000080);
-      PUT_UTF8_BYTE((ucs4_char & 0x0000003F) | 0x00000080);
-    } else if (ucs4_char < 0x04000000) {
-      PUT_UTF8_BYTE(((ucs4_char >> 24) & 0x00000003) | 0x000000F8);
-      PUT_UTF8_BYTE(((ucs4_char >> 18) & 0x0000003F) | 0x00000080);
-      PUT_UTF8_BYTE(((ucs4_char >> 12) & 0x0000003F) | 0x00000080);
-      PUT_UTF8_BYTE(((ucs4_char >> 6) & 0x0000003F) | 0x00000080);
-      PUT_UTF8_BYTE((ucs4_char & 0x0000003F) | 0x00000080);
-    } else /* if (ucs4_char < 0x80000000) */ {
-      PUT_UTF8_BYTE(((ucs4_char >> 30) & 0x00000001) | 0x000000FC);
-      PUT_UTF8_BYTE(((ucs4_char >> 24) & 0x0000003F) | 0x00000080);
-      PUT_UTF8_BYTE(((ucs4_char >> 18) & 0x0000003F) | 0x00000080);
-      PUT_UTF8_BYTE(((ucs4_char >> 12) & 0x0000003F) | 0x00000080);
-      PUT_UTF8_BYTE(((ucs4_char >> 6) & 0x0000003F) | 0x00000080);
-      PUT_UTF8_BYTE((ucs4_char & 0x0000003F) | 0x00000080);
-    }
-
-#undef PUT_UTF8_BYTE
 
-  }
+  /* The buffer is filled up to its end with whole characters */
+  bytes = utf8_encode(in_unicode_str, in_unicode_length,
+		      utf8_buffer, utf8_buffer_length, &consumed);
 
-  *out_uni_consumed_length_p = index;
-  *out_actual_utf8_buffer_length_p = index_utf8;
+  *out_uni_consumed_length_p = consumed;
+  *out_actual_utf8_buffer_length_p = bytes;
 
   return(TRUE);
 }
@@ -670,41 +738,283 @@ fribidi_utf8_to_unicode_p(guchar *in_utf8_str,          /* UTF8 string */
 							** Unicode buffer.
 							*/
 {
-  /* !!! To be improved using code from libutf8-0.7.3/src/mbstowcs/mbsrtowcs.c
-  ** !!! (the library is LGPLed :-) )
+  /* The conversion stops at the first malformed sequence, and never
+  ** reads beyond in_utf8_length octets or writes beyond
+  ** unicode_buffer_length characters.
   */
 
-  guint index;
-  guint index_uni;
+  gint consumed;
+  gint index_uni;
 
   if (NULL == in_utf8_str) return(FALSE);
   if (NULL == unicode_buffer) return(FALSE);
   if (NULL == out_utf8_consumed_length_p) return(FALSE);
   if (NULL == out_actual_unicode_buffer_length_p) return(FALSE);
 
-  /* If we are here, all outputs must have some valid values. */
-  *out_utf8_consumed_length_p = 0;
-  *out_actual_unicode_buffer_length_p = 0;
+  index_uni = utf8_decode(in_utf8_str, in_utf8_length,
+			  unicode_buffer, unicode_buffer_length,
+			  &consumed);
+
+  *out_utf8_consumed_length_p = consumed;
+  *out_actual_unicode_buffer_length_p = index_uni;
+
+  /* Stopping with room left in the buffer means a malformed sequence */
+  return(consumed == in_utf8_length || index_uni == unicode_buffer_length);
+}
+
+/*======================================================================
+//  The converters of the registry.
+//----------------------------------------------------------------------*/
+static gint
+decode_8bit(const FriBidiCharSet *char_set,
+	    guchar *s,
+	    gint len,
+	    /* Output */
+	    FriBidiChar *us,
+	    gint max_chars,
+	    gint *consumed)
+{
+  gint n = MIN(len, max_chars);
 
-  for (index = 0, index_uni = 0; (index < in_utf8_length) && (index_uni < unicode_buffer_length);) {
-    /* NOTE:  there is no protection against UTF8 sequences which overflow the in_utf8_str. */
-    if (in_utf8_str[index] <= 0177) /* one byte */ {
-      unicode_buffer[index_uni++] = in_utf8_str[index++]; /* expand with 0s */
+  fribidi_8bit_to_unicode(char_set->to_unicode, s, n, us);
+  *consumed = n;
+  return n;
+}
+
+static gint
+encode_8bit(const FriBidiCharSet *char_set,
+	    FriBidiChar *us,
+	    gint len,
+	    /* Output */
+	    guchar *s,
+	    gint size,
+	    gint *consumed)
+{
+  gint n = MIN(len, size);
+
+  fribidi_unicode_to_8bit(char_set->from_unicode_index,
+			  char_set->from_unicode_pages, us, n, s);
+  *consumed = n;
+  return n;
+}
+
+/* Whether the len bytes of s, fewer than a whole sequence, may be
+   completed by the bytes that follow them */
+static gboolean
+utf8_is_cut(guchar *s,
+	    gint len)
+{
+  guchar b = s[0];
+  gint need, i;
+
+  if (b >= 0xC2 && b <= 0xDF)
+    need = 2;
+  else if (b >= 0xE0 && b <= 0xEF)
+    need = 3;
+  else if (b >= 0xF0 && b <= 0xF4)
+    need = 4;
+  else
+    return FALSE;
+
+  if (len >= need)
+    return FALSE;
+  if (len >= 2
+      && ((b == 0xE0 && s[1] < 0xA0) || (b == 0xED && s[1] >= 0xA0)
+	  || (b == 0xF0 && s[1] < 0x90) || (b == 0xF4 && s[1] >= 0x90)))
+    return FALSE;
+  for (i=1; i<len; i++)
+    if (!UTF8_IS_CONT(s[i]))
+      return FALSE;
+  return TRUE;
+}
+
+static gint
+decode_utf8(const FriBidiCharSet *char_set,
+	    guchar *s,
+	    gint len,
+	    /* Output */
+	    FriBidiChar *us,
+	    gint max_chars,
+	    gint *consumed)
+{
+  gint i = 0, n = 0;
+
+  while (i < len && n < max_chars)
+    {
+      gint used;
+
+      n += utf8_decode(s + i, len - i, us + n, max_chars - n, &used);
+      i += used;
+      if (i < len && n < max_chars)
+	{
+	  if (utf8_is_cut(s + i, len - i))
+	    break;
+	  us[n++] = 0xFFFD;
+	  i++;
+	}
     }
-    else if (in_utf8_str[index] < 0340) /* 2 chars, such as Hebrew */ {
-      unicode_buffer[index_uni++] = ((in_utf8_str[index] & 037) << 6)
-	+ (in_utf8_str[index+1] & 077);
-      index += 2;
+
+  *consumed = i;
+  return n;
+}
+
+static gint
+encode_utf8(const FriBidiCharSet *char_set,
+	    FriBidiChar *us,
+	    gint len,
+	    /* Output */
+	    guchar *s,
+	    gint size,
+	    gint *consumed)
+{
+  return utf8_encode(us, len, s, size, consumed);
+}
+
+#define CHAR_SET_8BIT(id, name, title, cs)				\
+  { id, name, title, decode_8bit, encode_8bit,				\
+    fribidi_##cs##_to_unicode_table,					\
+    fribidi_unicode_to_##cs##_index,					\
+    fribidi_unicode_to_##cs##_pages }
+
+static const FriBidiCharSet char_sets[] = {
+  { FRIBIDI_CHARSET_UTF8, "UTF-8", "Unicode", decode_utf8, encode_utf8,
+    NULL, NULL, NULL },
+  CHAR_SET_8BIT(FRIBIDI_CHARSET_8859_6, "8859-6", "Arabic", iso8859_6),
+  CHAR_SET_8BIT(FRIBIDI_CHARSET_8859_8, "8859-8", "Hebrew", iso8859_8),
+  CHAR_SET_8BIT(FRIBIDI_CHARSET_CP1255, "CP1255", "Hebrew/Yiddish", cp1255),
+  CHAR_SET_8BIT(FRIBIDI_CHARSET_CP1256, "CP1256", "MS-Arabic", cp1256),
+  CHAR_SET_8BIT(FRIBIDI_CHARSET_ISIRI_3342, "ISIRI-3342", "Farsi", isiri_3342)
+};
+
+#define NUM_CHAR_SETS (sizeof(char_sets) / sizeof(char_sets[0]))
+
+const FriBidiCharSet *
+fribidi_char_set_nth(gint n)
+{
+  return (n >= 0 && n < NUM_CHAR_SETS) ? &char_sets[n] : NULL;
+}
+
+const FriBidiCharSet *
+fribidi_char_set_by_name(const gchar *name)
+{
+  gint i;
+
+  for (i=0; i<NUM_CHAR_SETS; i++)
+    if (strcmp(char_sets[i].name, name) == 0)
+      return &char_sets[i];
+  return NULL;
+}
+
+const FriBidiCharSet *
+fribidi_char_set_by_id(gint id)
+{
+  gint i;
+
+  for (i=0; i<NUM_CHAR_SETS; i++)
+    if (char_sets[i].id == id)
+      return &char_sets[i];
+  return NULL;
+}
+
+/*======================================================================
+//  The stream decoder.
+//----------------------------------------------------------------------*/
+void
+fribidi_char_set_decoder_init(FriBidiCharSetDecoder *dec,
+			      const FriBidiCharSet *char_set)
+{
+  dec->char_set = char_set;
+  dec->in = NULL;
+  dec->in_len = 0;
+  dec->carry_len = 0;
+}
+
+void
+fribidi_char_set_decoder_feed(FriBidiCharSetDecoder *dec,
+			      guchar *s,
+			      gint len)
+{
+  dec->in = s;
+  dec->in_len = len;
+}
+
+gint
+fribidi_char_set_decoder_drain(FriBidiCharSetDecoder *dec,
+			       /* Output */
+			       FriBidiChar *us,
+			       gint max_chars)
+{
+  const FriBidiCharSet *char_set = dec->char_set;
+  gint n = 0, used;
+
+  /* First complete the sequence carried over from the last block */
+  while (dec->carry_len > 0 && n < max_chars)
+    {
+      guchar buf[sizeof(dec->carry)];
+      gint take = MIN(dec->in_len, (gint)sizeof(buf) - dec->carry_len);
+      gint k;
+
+      memcpy(buf, dec->carry, dec->carry_len);
+      memcpy(buf + dec->carry_len, dec->in, take);
+      k = char_set->decode(char_set, buf, dec->carry_len + take,
+			   us + n, 1, &used);
+      if (k == 0)
+	{
+	  /* Still cut short, so the block is used up */
+	  memcpy(dec->carry + dec->carry_len, dec->in, take);
+	  dec->carry_len += take;
+	  dec->in += take;
+	  dec->in_len -= take;
+	  return n;
+	}
+
+      n += k;
+      if (used >= dec->carry_len)
+	{
+	  dec->in += used - dec->carry_len;
+	  dec->in_len -= used - dec->carry_len;
+	  dec->carry_len = 0;
+	}
+      else
+	{
+	  /* A malformed byte of the carry was decoded alone */
+	  memmove(dec->carry, dec->carry + used, dec->carry_len - used);
+	  dec->carry_len -= used;
+	}
     }
-    else /* 3 chars */ {
-      unicode_buffer[index_uni++] = ((in_utf8_str[index] & 017) << 12)
-	+ ((in_utf8_str[index+1] & 077) << 6)
-	+ (in_utf8_str[index+2] & 077);
-      index += 3;
+
+  if (dec->in_len > 0 && n < max_chars)
+    {
+      n += char_set->decode(char_set, dec->in, dec->in_len,
+			    us + n, max_chars - n, &used);
+      dec->in += used;
+      dec->in_len -= used;
+
+      /* Keep a sequence cut by the end of the block */
+      if (dec->in_len > 0 && n < max_chars)
+	{
+	  memcpy(dec->carry, dec->in, dec->in_len);
+	  dec->carry_len = dec->in_len;
+	  dec->in += dec->in_len;
+	  dec->in_len = 0;
+	}
     }
-  }
-  *out_utf8_consumed_length_p = index;
-  *out_actual_unicode_buffer_length_p = index_uni;
 
-  return(TRUE);
+  return n;
+}
+
+gint
+fribidi_char_set_decoder_finish(FriBidiCharSetDecoder *dec,
+				/* Output */
+				FriBidiChar *us,
+				gint max_chars)
+{
+  gint n = 0;
+
+  while (dec->carry_len > 0 && n < max_chars)
+    {
+      us[n++] = 0xFFFD;
+      memmove(dec->carry, dec->carry + 1, --dec->carry_len);
+    }
+  return n;
 }
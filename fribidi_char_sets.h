@@ -79,17 +79,72 @@ void            fribidi_unicode_to_iso8859_8       (FriBidiChar *us,
 						    guchar *s);
 
 
+/* Run the algorithm on text in one of the 8-bit character sets above,
+   without converting it to Unicode. The visual string is in the same
+   set, and the maps and the levels are in bytes. Returns FALSE for
+   UTF-8 and unknown sets */
+gboolean        fribidi_log2vis_charset             (gint char_set,
+                                                     guchar *str,
+                                                     gint len,
+                                                     FriBidiCharType *pbase_dir,
+                                                     /* Output */
+                                                     guchar *visual_str,
+                                                     guint16 *position_L_to_V_list,
+                                                     guint16 *position_V_to_L_list,
+                                                     guint8 *embedding_level_list);
+
+gboolean        fribidi_context_log2vis_charset     (FriBidiContext *ctx,
+                                                     gint char_set,
+                                                     guchar *str,
+                                                     gint len,
+                                                     FriBidiCharType *pbase_dir,
+                                                     /* Output */
+                                                     guchar *visual_str,
+                                                     guint16 *position_L_to_V_list,
+                                                     guint16 *position_V_to_L_list,
+                                                     guint8 *embedding_level_list);
+
 void            fribidi_unicode_to_utf8             (FriBidiChar *us,
                                                      int length,
                                                      /* Output */
                                                      guchar *s);
 /* warning: the length of output string may exceed the length of the input */
+/* s must have room for fribidi_utf8_encoded_length(us, length) + 1 bytes */
+
+gint            fribidi_utf8_encoded_length         (FriBidiChar *us,
+                                                     gint length);
+/* the number of bytes of the UTF-8 form, without a terminating zero */
+
+gint            fribidi_unicode_to_utf8_chunk       (FriBidiChar *us,
+                                                     gint length,
+                                                     guchar *s,
+                                                     gint size,
+                                                     /* Output */
+                                                     gint *consumed);
+/* encodes the whole characters that fit in size bytes, without a
+   terminating zero, and returns the number of bytes. Call it again
+   from us + *consumed to write the rest */
 
 int             fribidi_utf8_to_unicode             (guchar *s,
                                                      /* Output */
                                                      FriBidiChar *us);
 /* the length of the string is returned */
 
+gint            fribidi_utf8_to_unicode_checked     (guchar *s,
+                                                     gint len,
+                                                     /* Output */
+                                                     FriBidiChar *us,
+                                                     gint *error_pos);
+/* decodes len bytes into us, which must have room for len characters,
+   and stops at the first malformed sequence. *error_pos is its offset,
+   or -1. The number of characters is returned */
+
+gboolean        fribidi_utf8_validate               (guchar *s,
+                                                     gint len,
+                                                     /* Output */
+                                                     gint *error_pos);
+/* error_pos may be NULL */
+
 /* the following added by Omer Zak <omerz@actcom.co.il> Sept 2000.
 ** The following functions do the same thing, but have better-defined
 ** interfaces.
@@ -133,5 +188,72 @@ fribidi_utf8_to_unicode_p(guchar *in_utf8_str,          /* UTF8 string */
 							*/
 
 
+/*======================================================================
+//  The registry of character sets. A set is looked up once, by name or
+//  by id, and its converters are then called through the pointers.
+//
+//  decode() converts up to len bytes to at most max_chars characters,
+//  and returns their number and the bytes used in *consumed. It stops
+//  before a sequence that is cut by the end of the bytes; malformed
+//  bytes are decoded as U+FFFD. encode() writes the whole characters
+//  that fit in size bytes, and returns the number of bytes and the
+//  characters used in *consumed. Neither writes a terminating zero.
+//----------------------------------------------------------------------*/
+struct _FriBidiCharSet {
+  gint id;                      /* FRIBIDI_CHARSET_* */
+  const gchar *name;
+  const gchar *title;
+
+  gint (*decode) (const FriBidiCharSet *char_set,
+		  guchar *s, gint len,
+		  /* Output */
+		  FriBidiChar *us, gint max_chars, gint *consumed);
+  gint (*encode) (const FriBidiCharSet *char_set,
+		  FriBidiChar *us, gint len,
+		  /* Output */
+		  guchar *s, gint size, gint *consumed);
+
+  /* The tables of the 8-bit sets, or NULL */
+  const FriBidiChar *to_unicode;
+  const gint32 *from_unicode_index;
+  const guint8 *from_unicode_pages;
+};
+
+const FriBidiCharSet *fribidi_char_set_by_name     (const gchar *name);
+const FriBidiCharSet *fribidi_char_set_by_id       (gint id);
+/* The n'th set of the registry, or NULL past the last one */
+const FriBidiCharSet *fribidi_char_set_nth         (gint n);
+
+/*======================================================================
+//  A decoder converts a stream that arrives in blocks of any size. A
+//  block is given with fribidi_char_set_decoder_feed() and converted
+//  by calls to fribidi_char_set_decoder_drain() until it returns 0.
+//  A sequence cut by the end of a block is carried over to the next
+//  one. The block must stay valid until it is drained.
+//----------------------------------------------------------------------*/
+typedef struct {
+  const FriBidiCharSet *char_set;
+  guchar *in;
+  gint in_len;
+  guchar carry[4];
+  gint carry_len;
+} FriBidiCharSetDecoder;
+
+void            fribidi_char_set_decoder_init       (FriBidiCharSetDecoder *dec,
+                                                     const FriBidiCharSet *char_set);
+void            fribidi_char_set_decoder_feed       (FriBidiCharSetDecoder *dec,
+                                                     guchar *s,
+                                                     gint len);
+gint            fribidi_char_set_decoder_drain      (FriBidiCharSetDecoder *dec,
+                                                     /* Output */
+                                                     FriBidiChar *us,
+                                                     gint max_chars);
+/* At the end of the stream, decodes a sequence left cut short as one
+   U+FFFD for each byte, and returns their number */
+gint            fribidi_char_set_decoder_finish     (FriBidiCharSetDecoder *dec,
+                                                     /* Output */
+                                                     FriBidiChar *us,
+                                                     gint max_chars);
+
 #endif /* FRIBIDI_CHAR_SETS_H */
 
@@ -26,7 +26,13 @@
 //----------------------------------------------------------------------*/
 FriBidiCharType fribidi_get_type(FriBidiChar uch)
 {
-  guchar *block = FriBidiPropertyBlocks[uch / 256];
+  guchar *block;
+
+  /* The table only covers the basic multilingual plane */
+  if (uch >= 256 * 256)
+    return 0;
+
+  block = FriBidiPropertyBlocks[uch / 256];
   if (block)
     return block[uch % 256];
   else
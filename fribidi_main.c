@@ -26,8 +26,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <sched.h>
+#include <pthread.h>
 #include <glib.h>
 #include "fribidi.h"
+#include "fribidi_binary.h"
 
 #define CASE(s) if(!strcmp(S_, s))
 
@@ -43,85 +52,852 @@ void die(gchar *fmt, ...)
 #define UNI_ALEF 0x05D0
 #define UNI_TAV 0x05EA
 
-void charset_to_unicode(gint char_set,
-			guchar *s,
-			/* output */
-			FriBidiChar *us,
-			int *length
-			)
+/*======================================================================
+//  CapRTL, the default character set of the program, is ASCII with
+//  the capital letters taken as Hebrew letters. It is not one of the
+//  sets of the library, so its converters are defined here.
+//----------------------------------------------------------------------*/
+static gint caprtl_decode(const FriBidiCharSet *char_set,
+			  guchar *s, gint len,
+			  /* output */
+			  FriBidiChar *us, gint max_chars, gint *consumed)
 {
-  int i;
-  int len = strlen(s);
+  gint i, n = MIN(len, max_chars);
 
-  if (char_set == 0)
+  /* Convert A-Z into hebrew characters */
+  for (i=0; i<n; i++)
     {
-      /* Convert A-Z into hebrew characters */
-      for (i=0; i<len+1; i++)
-	{
-	  guchar ch = s[i];
+      guchar ch = s[i];
+
+      if (ch >= 'A' && ch <= 'Z')
+	us[i] = ch - 'A' + UNI_ALEF;
+      else
+	us[i] = ch;
+    }
+  *consumed = n;
+  return n;
+}
+
+static gint caprtl_encode(const FriBidiCharSet *char_set,
+			  FriBidiChar *us, gint len,
+			  /* output */
+			  guchar *s, gint size, gint *consumed)
+{
+  gint i, n = MIN(len, size);
+
+  /* Convert hebrew characters into A-Z */
+  for (i=0; i<n; i++)
+    {
+      FriBidiChar ch = us[i];
+
+      if (ch >= UNI_ALEF && ch <= UNI_TAV)
+	s[i] = ch-UNI_ALEF+'A';
+      else if (ch < 256)
+	s[i] = ch;
+      else
+	s[i] = '\xbf';
+    }
+  *consumed = n;
+  return n;
+}
+
+static const FriBidiCharSet caprtl_char_set = {
+  0, "CapRTL", "Capital letters as Hebrew", caprtl_decode, caprtl_encode,
+  NULL, NULL, NULL
+};
+
+/*======================================================================
+//  The line reader hands out the lines of the input without their
+//  newline, whatever their length. In stream mode a regular file is
+//  mapped into memory, and other input is read in large blocks;
+//  otherwise the input is read a line at a time, so that the program
+//  can be used interactively. A line is valid until the next call.
+//----------------------------------------------------------------------*/
+#define READ_BLOCK_SIZE (1 << 20)
+#define WRITE_BLOCK_SIZE (1 << 20)
+
+typedef struct {
+  FILE *file;
+  gboolean stream;
+  gboolean mapped;
+  gboolean eof;
+  guchar *buf;
+  gsize size;                   /* Allocated size of buf */
+  gsize start, end;             /* The bytes that have not been used */
+  gsize scanned;                /* Bytes after start without a newline */
+} LineReader;
+
+static void line_reader_init(LineReader *reader, FILE *file, gboolean stream)
+{
+  struct stat st;
+
+  memset(reader, 0, sizeof(*reader));
+  reader->file = file;
+  reader->stream = stream;
+
+  if (stream && fstat(fileno(file), &st) == 0 && S_ISREG(st.st_mode)
+      && st.st_size > 0 && (off_t)(gsize)st.st_size == st.st_size)
+    {
+      void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE,
+		       fileno(file), 0);
 
-	  if (ch >= 'A' && ch <= 'Z')
-	    us[i] = ch - 'A' + UNI_ALEF;
-	  else
-	    us[i] = s[i];
+      if (map != MAP_FAILED)
+	{
+#ifdef MADV_SEQUENTIAL
+	  madvise(map, st.st_size, MADV_SEQUENTIAL);
+#endif
+	  reader->mapped = TRUE;
+	  reader->eof = TRUE;
+	  reader->buf = map;
+	  reader->size = reader->end = st.st_size;
+	  return;
 	}
     }
-  else if (char_set == FRIBIDI_CHARSET_8859_6)
-      fribidi_iso8859_6_to_unicode(s, us);
-  else if (char_set == FRIBIDI_CHARSET_8859_8)
-      fribidi_iso8859_8_to_unicode(s, us);
-  else if (char_set == FRIBIDI_CHARSET_8859_6)
-      fribidi_iso8859_6_to_unicode(s, us);
-  else if (char_set == FRIBIDI_CHARSET_ISIRI_3342)
-      fribidi_isiri_3342_to_unicode(s, us);
-  else if (char_set == FRIBIDI_CHARSET_CP1255)
-      fribidi_cp1255_to_unicode(s, us);
-  else if (char_set == FRIBIDI_CHARSET_CP1256)
-      fribidi_cp1256_to_unicode(s, us);
-  else if (char_set == FRIBIDI_CHARSET_UTF8)
-      *length = fribidi_utf8_to_unicode(s, us);
+
+  reader->size = stream ? READ_BLOCK_SIZE : 2048;
+  reader->buf = malloc(reader->size);
+}
+
+static void line_reader_free(LineReader *reader)
+{
+  if (reader->mapped)
+    munmap(reader->buf, reader->size);
   else
-    die("Sorry! Not implemented!\n");
+    free(reader->buf);
 }
 
-void unicode_to_charset(gint char_set,
-			FriBidiChar *us,
-			int length,
-			/* output */
-			gchar *s)
+/* Read more input after the bytes that are left, and return FALSE at
+   the end of the input */
+static gboolean line_reader_fill(LineReader *reader)
 {
-  if (char_set == 0)
+  gsize n;
+
+  if (reader->start > 0)
+    {
+      memmove(reader->buf, reader->buf + reader->start,
+	      reader->end - reader->start);
+      reader->end -= reader->start;
+      reader->start = 0;
+    }
+  /* fgets() needs room for a byte and the terminating zero */
+  if (reader->end + 1 >= reader->size)
     {
-      /* Convert hebrew characters into A-Z */
-      int i = 0;
-      
-      while(us[i])
+      reader->size *= 2;
+      reader->buf = realloc(reader->buf, reader->size);
+      if (!reader->buf)
+	die("Out of memory!\n");
+    }
+
+  if (reader->stream)
+    n = fread(reader->buf + reader->end, 1, reader->size - reader->end,
+	      reader->file);
+  else if (fgets((gchar *) reader->buf + reader->end,
+		 reader->size - reader->end,
+		 reader->file))
+    n = strlen((gchar *) reader->buf + reader->end);
+  else
+    n = 0;
+
+  reader->end += n;
+  return n > 0;
+}
+
+static gboolean line_reader_next(LineReader *reader,
+				 /* output */
+				 guchar **line,
+				 gsize *len)
+{
+  guchar *newline;
+
+  for (;;)
+    {
+      newline = memchr(reader->buf + reader->start + reader->scanned, '\n',
+		       reader->end - reader->start - reader->scanned);
+      if (newline)
+	break;
+      reader->scanned = reader->end - reader->start;
+
+      if (reader->eof || !line_reader_fill(reader))
 	{
-	  FriBidiChar ch = us[i];
-	  if (ch >= UNI_ALEF && ch <= UNI_TAV)
-	    s[i] = ch-UNI_ALEF+'A';
-	  else if (us[i] < 256)
-	    s[i] = us[i];
-	  else
-	    s[i] = '';
-	  i++;
+	  /* The last line has no newline */
+	  reader->eof = TRUE;
+	  if (reader->start == reader->end)
+	    return FALSE;
+	  *line = reader->buf + reader->start;
+	  *len = reader->end - reader->start;
+	  reader->start = reader->end;
+	  reader->scanned = 0;
+	  return TRUE;
 	}
-      s[i] = 0;
     }
-  else if (char_set == FRIBIDI_CHARSET_8859_6)
-    fribidi_unicode_to_iso8859_6(us, length, s); 
-  else if (char_set == FRIBIDI_CHARSET_8859_8)
-    fribidi_unicode_to_iso8859_8(us, length, s);
-  else if (char_set == FRIBIDI_CHARSET_ISIRI_3342)
-    fribidi_unicode_to_isiri_3342(us, length, s);
-  else if (char_set == FRIBIDI_CHARSET_CP1255)
-    fribidi_unicode_to_cp1255(us, length, s);
-  else if (char_set == FRIBIDI_CHARSET_CP1256)
-    fribidi_unicode_to_cp1256(us, length, s);
-  else if (char_set == FRIBIDI_CHARSET_UTF8)
-      (void) fribidi_unicode_to_utf8(us, length, s);
+
+  *line = reader->buf + reader->start;
+  *len = newline - *line;
+  reader->start += *len + 1;
+  reader->scanned = 0;
+  return TRUE;
+}
+
+/*======================================================================
+//  The output buffer collects the output lines and writes them in
+//  large blocks. out_reserve() returns room for n bytes at the end of
+//  the buffer, and out_commit() adds the bytes that were used. Without
+//  a file the buffer grows instead, to hold the output of a batch.
+//----------------------------------------------------------------------*/
+typedef struct {
+  FILE *file;
+  guchar *buf;
+  gsize size, len;
+} OutBuf;
+
+static void out_init(OutBuf *out, FILE *file)
+{
+  out->file = file;
+  out->size = WRITE_BLOCK_SIZE;
+  out->len = 0;
+  out->buf = malloc(out->size);
+}
+
+static void out_flush(OutBuf *out)
+{
+  if (out->len && fwrite(out->buf, 1, out->len, out->file) != out->len)
+    die("Write error!\n");
+  out->len = 0;
+}
+
+static guchar *out_reserve(OutBuf *out, gsize n)
+{
+  if (out->len + n > out->size && out->file)
+    out_flush(out);
+  if (out->len + n > out->size)
+    {
+      out->size = MAX(2 * out->size, out->len + n);
+      out->buf = realloc(out->buf, out->size);
+      if (!out->buf)
+	die("Out of memory!\n");
+    }
+  return out->buf + out->len;
+}
+
+static void out_commit(OutBuf *out, gsize n)
+{
+  out->len += n;
+}
+
+static void out_write(OutBuf *out, const guchar *s, gsize n)
+{
+  memcpy(out_reserve(out, n), s, n);
+  out_commit(out, n);
+}
+
+static void out_free(OutBuf *out)
+{
+  if (out->file)
+    out_flush(out);
+  free(out->buf);
+}
+
+/*======================================================================
+//  The options of the program, and the buffers that a thread keeps
+//  from line to line, each of them with room for a piece of a line.
+//----------------------------------------------------------------------*/
+typedef struct {
+  const FriBidiCharSet *char_set;
+  FriBidiCharType base_dir;
+  gint text_width;
+  gboolean do_pad;
+  gboolean do_fill;
+  gboolean do_binary;
+  guchar *bol_text, *eol_text;
+  gsize bol_len, eol_len;
+} Options;
+
+typedef struct {
+  FriBidiContext *ctx;
+  FriBidiChar *us;
+  FriBidiChar *visual;          /* A filled line */
+  guint8 *levels;
+  gsize *piece_lens;            /* The bytes of each piece of a line */
+  gint max_pieces;
+} Scratch;
+
+static void scratch_init(Scratch *scratch)
+{
+  scratch->ctx = fribidi_context_new(NULL);
+  scratch->us = malloc(sizeof(FriBidiChar) * FRIBIDI_MAX_STRING_LENGTH);
+  scratch->visual = malloc(sizeof(FriBidiChar) * FRIBIDI_MAX_STRING_LENGTH);
+  scratch->levels = malloc(FRIBIDI_MAX_STRING_LENGTH);
+  scratch->piece_lens = NULL;
+  scratch->max_pieces = 0;
+  if (!scratch->us || !scratch->visual || !scratch->levels)
+    die("Out of memory!\n");
+}
+
+static void scratch_free(Scratch *scratch)
+{
+  free(scratch->piece_lens);
+  free(scratch->levels);
+  free(scratch->visual);
+  free(scratch->us);
+  fribidi_context_destroy(scratch->ctx);
+}
+
+/* Decode at most a piece of s, with a U+FFFD for each byte of a
+   sequence that is cut by the end of the line */
+static gint decode_piece(const FriBidiCharSet *char_set,
+			 guchar *s,
+			 gint len,
+			 /* output */
+			 FriBidiChar *us,
+			 gint *consumed)
+{
+  gint n = char_set->decode(char_set, s, len,
+			    us, FRIBIDI_MAX_STRING_LENGTH, consumed);
+
+  for (; *consumed < len && n < FRIBIDI_MAX_STRING_LENGTH; (*consumed)++)
+    us[n++] = 0xFFFD;
+  return n;
+}
+
+/*======================================================================
+//  fill_line() wraps a line at the width of the text. Each piece of
+//  the line is analysed once and broken at whitespace into lines of at
+//  most text_width characters, or inside a word that is longer. The
+//  lines are reordered from the levels of the piece, and the
+//  whitespace at the breaks is dropped.
+//----------------------------------------------------------------------*/
+#define IS_BREAK_SPACE(ch) (fribidi_get_type(ch) == FRIBIDI_TYPE_WS)
+
+static void write_filled_line(const Options *opt,
+			      Scratch *scratch,
+			      FriBidiChar *us,
+			      guint8 *levels,
+			      gint len,
+			      FriBidiCharType base,
+			      OutBuf *out)
+{
+  gint pad = 0, bytes, consumed;
+  guchar *text;
+
+  if (base == FRIBIDI_TYPE_R && opt->do_pad && opt->text_width > len)
+    pad = opt->text_width - len;
+
+  out_write(out, opt->bol_text, opt->bol_len);
+  text = out_reserve(out, pad + 4 * len);
+  memset(text, ' ', pad);
+
+  fribidi_context_reorder_line(scratch->ctx, us, len, levels,
+			       /* output */
+			       scratch->visual, NULL, NULL);
+  bytes = opt->char_set->encode(opt->char_set, scratch->visual, len,
+				text + pad, 4 * len, &consumed);
+  out_commit(out, pad + bytes);
+
+  out_write(out, opt->eol_text, opt->eol_len);
+  out_write(out, (guchar *) "\n", 1);
+}
+
+static void fill_line(const Options *opt,
+		      Scratch *scratch,
+		      guchar *line,
+		      gsize len,
+		      OutBuf *out)
+{
+  FriBidiChar *us = scratch->us;
+  FriBidiCharType base = opt->base_dir;
+  gint width = opt->text_width;
+  gsize pos = 0;
+
+  do
+    {
+      gint left = MIN(len - pos, G_MAXINT);
+      gint n, consumed, start = 0;
+
+      n = decode_piece(opt->char_set, line + pos, left, us, &consumed);
+      pos += consumed;
+
+      fribidi_context_log2vis_get_embedding_levels(scratch->ctx, us, n, &base,
+						   /* output */
+						   scratch->levels);
+      do
+	{
+	  gint end = n;
+
+	  if (n - start > width)
+	    {
+	      /* Break at the last whitespace that fits, if there is one */
+	      end = start + width;
+	      while (end > start && !IS_BREAK_SPACE(us[end]))
+		end--;
+	      if (end == start)
+		end = start + width;
+	    }
+	  write_filled_line(opt, scratch, us + start, scratch->levels + start,
+			    end - start, base, out);
+
+	  for (start = end; start < n && IS_BREAK_SPACE(us[start]); start++)
+	    ;
+	}
+      while (start < n);
+    }
+  while (pos < len);
+}
+
+/*======================================================================
+//  write_binary_line() writes the records of fribidi_binary.h for a
+//  line. The maps and the visual text are written by the library
+//  straight into the record, and the level runs after them.
+//----------------------------------------------------------------------*/
+static void write_binary_line(const Options *opt,
+			      Scratch *scratch,
+			      guchar *line,
+			      gsize len,
+			      OutBuf *out)
+{
+  FriBidiChar *us = scratch->us;
+  guint8 *levels = scratch->levels;
+  FriBidiCharType base = opt->base_dir;
+  gsize pos = 0;
+
+  do
+    {
+      gint left = MIN(len - pos, G_MAXINT);
+      gint n, consumed, i, num_runs;
+      FriBidiBinaryLine *record;
+      FriBidiBinaryLevelRun *runs;
+      guint16 *position_L_to_V_list, *position_V_to_L_list;
+      guchar *text;
+      gsize size;
+
+      n = decode_piece(opt->char_set, line + pos, left, us, &consumed);
+      pos += consumed;
+
+      /* A character takes at most four bytes of text */
+      record = (FriBidiBinaryLine *)
+	out_reserve(out, FRIBIDI_BINARY_MAX_RECORD_SIZE(n, 4 * n));
+      position_L_to_V_list = (guint16 *)(record + 1);
+      position_V_to_L_list = position_L_to_V_list + n;
+      text = (guchar *)(position_V_to_L_list + n);
+
+      record->len = n;
+      record->text_bytes =
+	fribidi_context_log2vis_to_charset(scratch->ctx, us, n, &base,
+					   opt->char_set,
+					   /* output */
+					   text, 4 * n, NULL,
+					   position_L_to_V_list,
+					   position_V_to_L_list,
+					   levels);
+      memset(text + record->text_bytes, 0,
+	     FRIBIDI_BINARY_ALIGN(record->text_bytes, 4) - record->text_bytes);
+
+      runs = (FriBidiBinaryLevelRun *) FRIBIDI_BINARY_LEVEL_RUNS(record);
+      num_runs = 0;
+      for (i=0; i<n; num_runs++)
+	{
+	  gint start = i;
+
+	  while (i < n && levels[i] == levels[start])
+	    i++;
+	  runs[num_runs].length = i - start;
+	  runs[num_runs].level = levels[start];
+	  runs[num_runs].reserved = 0;
+	}
+
+      record->num_level_runs = num_runs;
+      record->base_level = (base == FRIBIDI_TYPE_R);
+      record->flags = pos < len ? FRIBIDI_BINARY_CONTINUED : 0;
+
+      size = (guchar *)(runs + num_runs) - (guchar *) record;
+      record->record_size = FRIBIDI_BINARY_ALIGN(size, 8);
+      memset((guchar *) record + size, 0, record->record_size - size);
+      out_commit(out, record->record_size);
+    }
+  while (pos < len);
+}
+
+/*======================================================================
+//  process_line() reorders a line and writes it to out. The library
+//  takes at most FRIBIDI_MAX_STRING_LENGTH characters at a time, so
+//  longer lines are reordered in pieces of that length, all with the
+//  base direction of the first piece, and the pieces of a right to
+//  left line are then put in right to left order. The visual text is
+//  written straight into the output buffer.
+//----------------------------------------------------------------------*/
+static void reverse_bytes(guchar *s, gsize len)
+{
+  gsize i;
+
+  for (i=0; i<len/2; i++)
+    {
+      guchar c = s[i];
+
+      s[i] = s[len - 1 - i];
+      s[len - 1 - i] = c;
+    }
+}
+
+/* Reverse the order of the pieces, and then the bytes of each piece
+   back, so that the last piece comes first */
+static void reverse_pieces(guchar *text,
+			   gsize text_len,
+			   const gsize *piece_lens,
+			   gint num_pieces)
+{
+  gsize off = 0;
+  gint k;
+
+  reverse_bytes(text, text_len);
+  for (k=num_pieces-1; k>=0; k--)
+    {
+      reverse_bytes(text + off, piece_lens[k]);
+      off += piece_lens[k];
+    }
+}
+
+static void process_line(const Options *opt,
+			 Scratch *scratch,
+			 guchar *line,
+			 gsize len,
+			 OutBuf *out)
+{
+  const FriBidiCharSet *char_set = opt->char_set;
+  FriBidiContext *ctx = scratch->ctx;
+  FriBidiChar *us = scratch->us;
+  FriBidiCharType base = opt->base_dir;
+  gsize pos = 0, num_chars = 0, text_len = 0, pad = 0;
+  gsize room = 4 * len + MAX(opt->text_width, 0);
+  guchar *text;
+  gint num_pieces = 0;
+
+  if (opt->do_binary)
+    {
+      write_binary_line(opt, scratch, line, len, out);
+      return;
+    }
+
+  if (opt->do_fill && opt->text_width > 0)
+    {
+      fill_line(opt, scratch, line, len, out);
+      return;
+    }
+
+  out_write(out, opt->bol_text, opt->bol_len);
+
+  /* A character takes at most four bytes, or three as the U+FFFD of a
+     malformed byte */
+  text = out_reserve(out, room);
+  do
+    {
+      gint left = MIN(len - pos, G_MAXINT);
+      gint n, consumed, piece_len;
+
+      /* The 8-bit sets are reordered as they are, without a round
+	 trip through Unicode */
+      if (char_set->to_unicode
+	  && fribidi_context_log2vis_charset(ctx, char_set->id, line + pos,
+					     MIN(left, FRIBIDI_MAX_STRING_LENGTH),
+					     &base,
+					     /* output */
+					     text + text_len, NULL, NULL, NULL))
+	n = consumed = piece_len = MIN(left, FRIBIDI_MAX_STRING_LENGTH);
+      else
+	{
+	  n = decode_piece(char_set, line + pos, left, us, &consumed);
+
+	  /* Create a bidi string, encoded as it is reordered */
+	  piece_len = fribidi_context_log2vis_to_charset(ctx,
+							 us,
+							 n,
+							 &base,
+							 char_set,
+							 /* output */
+							 text + text_len,
+							 room - text_len,
+							 NULL,   /* Always fits in room */
+							 NULL,   /* No need for log_to_vis mapping */
+							 NULL,   /* No need for vis_to_log mapping */
+							 NULL    /* No need for embedding level */
+							 );
+	}
+      pos += consumed;
+      num_chars += n;
+      text_len += piece_len;
+
+      if (num_pieces == scratch->max_pieces)
+	{
+	  scratch->max_pieces = MAX(2 * scratch->max_pieces, 16);
+	  scratch->piece_lens = realloc(scratch->piece_lens,
+					sizeof(gsize) * scratch->max_pieces);
+	  if (!scratch->piece_lens)
+	    die("Out of memory!\n");
+	}
+      scratch->piece_lens[num_pieces++] = piece_len;
+    }
+  while (pos < len);
+
+  if (base == FRIBIDI_TYPE_R && num_pieces > 1)
+    reverse_pieces(text, text_len, scratch->piece_lens, num_pieces);
+
+  if (base == FRIBIDI_TYPE_R && opt->do_pad
+      && opt->text_width > 0 && (gsize) opt->text_width > num_chars)
+    {
+      pad = opt->text_width - num_chars;
+      memmove(text + pad, text, text_len);
+      memset(text, ' ', pad);
+    }
+  out_commit(out, pad + text_len);
+
+  out_write(out, opt->eol_text, opt->eol_len);
+  out_write(out, (guchar *) "\n", 1);
+}
+
+static double wall_time(void)
+{
+  struct timeval tv;
+
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + 1e-6 * tv.tv_usec;
+}
+
+/*======================================================================
+//  The pipeline of -j runs the reader in the main thread, the workers
+//  and a writer. The reader copies the lines into batches and hands
+//  them to the workers in turn, and the writer takes them back from
+//  the workers in the same turn, so the output keeps the order of the
+//  input. The threads are joined by single producer, single consumer
+//  rings. The batches come from a fixed pool that the writer returns
+//  them to, which bounds the memory whatever the size of the input.
+//----------------------------------------------------------------------*/
+#define BATCH_LINES 1024
+#define BATCH_BYTES (256 * 1024)
+#define BATCHES_PER_WORKER 4
+
+typedef struct {
+  guchar *in;                   /* The lines one after the other */
+  gsize in_size, in_len;
+  gsize ends[BATCH_LINES];      /* The end of each line in in */
+  gint num_lines;
+  OutBuf out;
+} Batch;
+
+/* Sent down the pipeline after the last batch */
+static Batch end_of_input;
+
+typedef struct {
+  Batch **slots;
+  guint mask;
+  guint head;                   /* Moved by the consumer */
+  gchar pad[64];                /* Keeps the ends on different lines */
+  guint tail;                   /* Moved by the producer */
+} BatchRing;
+
+static void ring_init(BatchRing *ring, guint size)
+{
+  guint capacity = 1;
+
+  while (capacity < size)
+    capacity *= 2;
+  ring->slots = malloc(sizeof(Batch *) * capacity);
+  ring->mask = capacity - 1;
+  ring->head = ring->tail = 0;
+}
+
+/* A thread that has to wait yields the processor for a while, then
+   sleeps, since a batch takes long to process */
+static void ring_wait(gint *spins)
+{
+  if (++*spins < 64)
+    sched_yield();
   else
-    die("Sorry! Not implemented!\n");
+    usleep(50);
+}
+
+/* Only the producer moves the tail and only the consumer the head */
+static void ring_push(BatchRing *ring, Batch *batch)
+{
+  guint tail = ring->tail;
+  gint spins = 0;
+
+  while (tail - __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) > ring->mask)
+    ring_wait(&spins);
+  ring->slots[tail & ring->mask] = batch;
+  __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+static Batch *ring_pop(BatchRing *ring)
+{
+  guint head = ring->head;
+  Batch *batch;
+  gint spins = 0;
+
+  while (__atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == head)
+    ring_wait(&spins);
+  batch = ring->slots[head & ring->mask];
+  __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+  return batch;
+}
+
+typedef struct {
+  const Options *opt;
+  BatchRing in, out;
+  pthread_t thread;
+} Worker;
+
+typedef struct {
+  Worker *workers;
+  gint num_workers;
+  BatchRing *free_batches;
+  FILE *file;
+  pthread_t thread;
+} Writer;
+
+/* Each worker has a context of its own */
+static void *worker_main(void *data)
+{
+  Worker *worker = data;
+  Scratch scratch;
+  Batch *batch;
+
+  scratch_init(&scratch);
+  while ((batch = ring_pop(&worker->in)) != &end_of_input)
+    {
+      gsize start = 0;
+      gint i;
+
+      for (i=0; i<batch->num_lines; i++)
+	{
+	  process_line(worker->opt, &scratch, batch->in + start,
+		       batch->ends[i] - start, &batch->out);
+	  start = batch->ends[i];
+	}
+      ring_push(&worker->out, batch);
+    }
+  ring_push(&worker->out, &end_of_input);
+
+  scratch_free(&scratch);
+  return NULL;
+}
+
+static void *writer_main(void *data)
+{
+  Writer *writer = data;
+  Batch *batch;
+  gint turn = 0;
+
+  while ((batch = ring_pop(&writer->workers[turn].out)) != &end_of_input)
+    {
+      if (batch->out.len
+	  && fwrite(batch->out.buf, 1, batch->out.len, writer->file)
+	     != batch->out.len)
+	die("Write error!\n");
+      batch->out.len = 0;
+      ring_push(writer->free_batches, batch);
+      turn = (turn + 1) % writer->num_workers;
+    }
+  fflush(writer->file);
+  return NULL;
+}
+
+/* Returns the number of bytes read */
+static gsize run_pipeline(const Options *opt,
+			  LineReader *reader,
+			  gint num_workers,
+			  FILE *file)
+{
+  gint num_batches = num_workers * BATCHES_PER_WORKER;
+  Batch *batches = calloc(num_batches, sizeof(Batch));
+  Worker *workers = calloc(num_workers, sizeof(Worker));
+  BatchRing free_batches;
+  Writer writer;
+  Batch *batch = NULL;
+  guchar *line;
+  gsize len, total = 0;
+  gint i, turn = 0;
+
+  ring_init(&free_batches, num_batches);
+  for (i=0; i<num_batches; i++)
+    {
+      batches[i].in_size = BATCH_BYTES;
+      batches[i].in = malloc(batches[i].in_size);
+      out_init(&batches[i].out, NULL);
+      ring_push(&free_batches, &batches[i]);
+    }
+
+  for (i=0; i<num_workers; i++)
+    {
+      workers[i].opt = opt;
+      ring_init(&workers[i].in, num_batches + 1);
+      ring_init(&workers[i].out, num_batches + 1);
+      if (pthread_create(&workers[i].thread, NULL, worker_main, &workers[i]))
+	die("Can't create a thread!\n");
+    }
+  writer.workers = workers;
+  writer.num_workers = num_workers;
+  writer.free_batches = &free_batches;
+  writer.file = file;
+  if (pthread_create(&writer.thread, NULL, writer_main, &writer))
+    die("Can't create a thread!\n");
+
+  while (line_reader_next(reader, &line, &len))
+    {
+      if (!batch)
+	{
+	  batch = ring_pop(&free_batches);
+	  batch->in_len = 0;
+	  batch->num_lines = 0;
+	}
+
+      /* A batch holds at least one line, however long */
+      if (batch->in_len + len > batch->in_size)
+	{
+	  batch->in_size = MAX(2 * batch->in_size, batch->in_len + len);
+	  batch->in = realloc(batch->in, batch->in_size);
+	  if (!batch->in)
+	    die("Out of memory!\n");
+	}
+      memcpy(batch->in + batch->in_len, line, len);
+      batch->in_len += len;
+      batch->ends[batch->num_lines++] = batch->in_len;
+      total += len + 1;
+
+      if (batch->num_lines == BATCH_LINES || batch->in_len >= BATCH_BYTES)
+	{
+	  ring_push(&workers[turn].in, batch);
+	  turn = (turn + 1) % num_workers;
+	  batch = NULL;
+	}
+    }
+  if (batch)
+    {
+      ring_push(&workers[turn].in, batch);
+      turn = (turn + 1) % num_workers;
+    }
+
+  /* The writer stops at the first end it meets, which comes after the
+     last batch in its turn */
+  for (i=0; i<num_workers; i++)
+    ring_push(&workers[(turn + i) % num_workers].in, &end_of_input);
+
+  for (i=0; i<num_workers; i++)
+    pthread_join(workers[i].thread, NULL);
+  pthread_join(writer.thread, NULL);
+
+  for (i=0; i<num_workers; i++)
+    {
+      free(workers[i].in.slots);
+      free(workers[i].out.slots);
+    }
+  for (i=0; i<num_batches; i++)
+    {
+      free(batches[i].in);
+      out_free(&batches[i].out);
+    }
+  free(free_batches.slots);
+  free(workers);
+  free(batches);
+
+  return total;
 }
 
 int main(int argc, char *argv[])
@@ -131,7 +907,11 @@ int main(int argc, char *argv[])
   gboolean text_width = 80;
   gboolean do_pad = TRUE;
   gboolean do_fill = FALSE;
-  gint char_set = 0;
+  gboolean do_stream = FALSE;
+  gboolean do_binary = FALSE;
+  gint num_workers = 0;
+  const FriBidiCharSet *char_set = &caprtl_char_set;
+  int i;
   guchar *bol_text = NULL, *eol_text = NULL;
   FriBidiCharType input_base_direction = FRIBIDI_TYPE_N;
   
@@ -149,21 +929,23 @@ int main(int argc, char *argv[])
 		 "\n"
 		 "Options:\n"
 		 "    -nopad       Don't right adjustify RTL lines\n"
-		 "    -fill        Fill lines up to margin. (Not implemented).\n"
+		 "    -fill        Fill lines up to margin, breaking them at whitespace.\n"
 		 "    -width w     Specify width of text\n"
 		 "    -eol eol     End lines with the string given by eol.\n"
 		 "    -bol bol     Start lines with the string given by bol.\n"
 		 "    -rtl         Force base direction to RTL.\n"
 		 "    -ltr         Force base direction to LTR.\n"
+		 "    -stream      Read the input in large blocks or map it into memory,\n"
+		 "                 buffer the output, and report the throughput.\n"
+		 "    -j n         Reorder the lines in n threads, in batches.\n"
+		 "    -binary      Write the visual text, the maps and the levels of\n"
+		 "                 each line in the format of fribidi_binary.h.\n"
 		 "    -charset cs  Specify charset. Default is CapRTL. Available options are:\n"
-		 "                     * 8859-8 (Hebrew)\n"
-		 "                     * 8859-6 (Arabic)\n"
-		 "                     * CP1255 (Hebrew/Yiddish)\n"
-		 "                     * CP1256 (MS-Arabic)\n"
-		 "                     * ISIRI-3342 (Farsi)\n"
-                 "                     * UTF-8\n"
-
 		 );
+	  for (i=0; fribidi_char_set_nth(i); i++)
+	    printf("                     * %s (%s)\n",
+		   fribidi_char_set_nth(i)->name,
+		   fribidi_char_set_nth(i)->title);
 	  
 	  exit(0);
 	}
@@ -174,22 +956,18 @@ int main(int argc, char *argv[])
       CASE("-rtl")   { input_base_direction = FRIBIDI_TYPE_R; continue; }
       CASE("-ltr")   { input_base_direction = FRIBIDI_TYPE_L; continue; }
       CASE("-fill")  { do_fill = TRUE; continue; };
+      CASE("-stream") { do_stream = TRUE; continue; };
+      CASE("-j")     { num_workers = atoi(argv[argp++]); continue; }
+      CASE("-binary") { do_binary = TRUE; continue; }
       CASE("-charset")
 	{
-	  gchar *S_ = argv[argp++];
-	  while(1) {
-	    CASE("CP1255") { char_set = FRIBIDI_CHARSET_CP1255; break; }
-	    CASE("CP1256") { char_set = FRIBIDI_CHARSET_CP1256; break; }
-	    CASE("8859-6") { char_set = FRIBIDI_CHARSET_8859_8; break; }
-	    CASE("8859-8") { char_set = FRIBIDI_CHARSET_8859_8; break; }
-	    CASE("ISIRI-3342") { char_set = FRIBIDI_CHARSET_ISIRI_3342; break;}
-            CASE("UTF-8")  { char_set = FRIBIDI_CHARSET_UTF8; break; }
-	    die("Unknown char set %s!\n", S_);
-	  }
+	  gchar *name = argv[argp++];
+
+	  char_set = fribidi_char_set_by_name(name);
+	  if (!char_set)
+	    die("Unknown char set %s!\n", name);
 	  continue;
 	}
-      
-	
 
       die("Unknown option %s!\n", S_);
     }
@@ -205,53 +983,76 @@ int main(int argc, char *argv[])
       IN = fopen(fn, "r");
     }
 
+  if (!IN)
+    die("Can't open input!\n");
+
   /* Read and process input one line at a time */
   {
-    guchar S_[2048];
-    
-    while(fgets(S_, sizeof(S_), IN))
+    LineReader reader;
+    OutBuf out;
+    Options opt;
+    guchar *line;
+    gsize len, total = 0;
+    double time0 = wall_time();
+
+    opt.char_set = char_set;
+    opt.base_dir = input_base_direction;
+    opt.text_width = text_width;
+    opt.do_pad = do_pad;
+    opt.do_fill = do_fill;
+    opt.do_binary = do_binary;
+    opt.bol_text = bol_text;
+    opt.bol_len = bol_text ? strlen((gchar *) bol_text) : 0;
+    opt.eol_text = eol_text;
+    opt.eol_len = eol_text ? strlen((gchar *) eol_text) : 0;
+
+    /* The batches of the threads are read as a stream */
+    line_reader_init(&reader, IN, do_stream || num_workers > 0);
+
+    if (do_binary)
       {
-	int len = strlen(S_);
-	FriBidiChar us[2048], out_us[2048];
-	guchar outstring[2048];
-	FriBidiCharType base;
-	int i;
-
-	/* chop */
-	if (S_[len-1] == '\n')
-	  S_[len-1] = '\0';
-
-	len--;
-
-	charset_to_unicode(char_set, S_, us, &len);
-      
-	/* Create a bidi string */
-	base = input_base_direction;
-	fribidi_log2vis(us,
-			len,
-			&base,
-			/* output */
-			out_us,
-			NULL,   /* No need for log_to_vis mapping */
-			NULL,   /* No need for vis_to_log mapping */
-			NULL    /* No need for embedding level */
-			);
-
-	/* Convert it to something to print */
-	unicode_to_charset(char_set, out_us, len, outstring);
-
-	if (bol_text)
-	  printf("%s", bol_text);
-	
-	if (base == FRIBIDI_TYPE_R && do_pad)
-	  for (i=0; i<text_width-len; i++)
-	    printf(" ");
-
-	printf("%s", outstring);
-	if (eol_text)
-	  printf("%s", eol_text);
-	printf("\n");
-      } /* one line worth */
+	FriBidiBinaryHeader header;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, FRIBIDI_BINARY_MAGIC, 4);
+	header.version = FRIBIDI_BINARY_VERSION;
+	header.byte_order = FRIBIDI_BINARY_BYTE_ORDER;
+	header.char_set = char_set->id;
+	if (fwrite(&header, sizeof(header), 1, stdout) != 1)
+	  die("Write error!\n");
+      }
+
+    if (num_workers > 0)
+      total = run_pipeline(&opt, &reader, num_workers, stdout);
+    else
+      {
+	Scratch scratch;
+
+	scratch_init(&scratch);
+	out_init(&out, stdout);
+	while (line_reader_next(&reader, &line, &len))
+	  {
+	    process_line(&opt, &scratch, line, len, &out);
+	    total += len + 1;
+
+	    /* Lines read one at a time are written one at a time */
+	    if (!do_stream)
+	      out_flush(&out);
+	  } /* one line worth */
+	out_free(&out);
+
+	scratch_free(&scratch);
+      }
+    line_reader_free(&reader);
+
+    if (do_stream)
+      {
+	double seconds = wall_time() - time0;
+
+	fprintf(stderr, "fribidi: %lu bytes in %.3f s, %.1f MB/s\n",
+		(unsigned long) total, seconds,
+		seconds > 0 ? total / seconds / 1e6 : 0.0);
+      }
   }
   return 0;
 }
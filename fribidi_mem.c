@@ -0,0 +1,396 @@
+/* FriBidi - Library of BiDi algorithm
+ * Copyright (C) 1999 Dov Grobgeld
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*======================================================================
+//  This file contains the memory management of the library: the
+//  built in allocators, the contexts that use them, and the pool of
+//  run-length links that is kept between calls.
+//----------------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <glib.h>
+#include "fribidi_private.h"
+
+/*======================================================================
+//  The glib and the malloc allocators. Neither of them can release
+//  its memory wholesale, so they have no reset function.
+//----------------------------------------------------------------------*/
+static gpointer glib_alloc(gsize size, gpointer user_data)
+{
+  return g_malloc(size);
+}
+
+static void glib_free(gpointer mem, gpointer user_data)
+{
+  g_free(mem);
+}
+
+static gpointer malloc_alloc(gsize size, gpointer user_data)
+{
+  return malloc(size);
+}
+
+static void malloc_free(gpointer mem, gpointer user_data)
+{
+  free(mem);
+}
+
+FriBidiAllocator fribidi_allocator_glib = {
+  glib_alloc, glib_free, NULL, NULL
+};
+
+FriBidiAllocator fribidi_allocator_malloc = {
+  malloc_alloc, malloc_free, NULL, NULL
+};
+
+/*======================================================================
+//  The arena allocator hands out memory by bumping a pointer in a
+//  list of blocks. Single allocations are never freed; instead all
+//  the memory is recycled at once when the arena is reset.
+//----------------------------------------------------------------------*/
+typedef struct _ArenaBlock ArenaBlock;
+
+struct _ArenaBlock {
+  ArenaBlock *next;
+  gsize size;
+  gsize used;
+};
+
+typedef struct {
+  FriBidiAllocator allocator;   /* Must be first */
+  gsize block_size;
+  ArenaBlock *blocks;
+  ArenaBlock *current;
+} Arena;
+
+#define ARENA_ALIGN(n) (((n) + 7) & ~((gsize)7))
+#define ARENA_BLOCK_HEADER ARENA_ALIGN(sizeof(ArenaBlock))
+
+static ArenaBlock *arena_block_new(gsize size)
+{
+  ArenaBlock *block = (ArenaBlock*)g_malloc(ARENA_BLOCK_HEADER + size);
+
+  block->next = NULL;
+  block->size = size;
+  block->used = 0;
+  return block;
+}
+
+static gpointer arena_alloc(gsize size, gpointer user_data)
+{
+  Arena *arena = (Arena*)user_data;
+  ArenaBlock *block = arena->current;
+  gpointer mem;
+
+  size = ARENA_ALIGN(size);
+
+  /* Move on to the next block that has room, creating it if needed.
+     The blocks that are passed over are reused after the next reset. */
+  while (block->used + size > block->size)
+    {
+      if (!block->next)
+	block->next = arena_block_new(MAX(arena->block_size, size));
+      block = block->next;
+    }
+  arena->current = block;
+
+  mem = (guchar*)block + ARENA_BLOCK_HEADER + block->used;
+  block->used += size;
+  return mem;
+}
+
+static void arena_free(gpointer mem, gpointer user_data)
+{
+  /* Nothing. The memory is released when the arena is reset. */
+}
+
+static void arena_reset(gpointer user_data)
+{
+  Arena *arena = (Arena*)user_data;
+  ArenaBlock *block;
+
+  for (block = arena->blocks; block; block = block->next)
+    block->used = 0;
+  arena->current = arena->blocks;
+}
+
+/*======================================================================
+//  fribidi_allocator_arena_new() creates a bump allocator that gets
+//  its memory from the system in blocks of block_size bytes. A
+//  block_size of 0 selects a default size.
+//----------------------------------------------------------------------*/
+FriBidiAllocator *
+fribidi_allocator_arena_new(gsize block_size)
+{
+  Arena *arena = g_new(Arena, 1);
+
+  if (block_size == 0)
+    block_size = FRIBIDI_ARENA_DEFAULT_BLOCK_SIZE;
+
+  arena->allocator.alloc = arena_alloc;
+  arena->allocator.free = arena_free;
+  arena->allocator.reset = arena_reset;
+  arena->allocator.user_data = arena;
+  arena->block_size = block_size;
+  arena->blocks = arena->current = arena_block_new(block_size);
+
+  return &arena->allocator;
+}
+
+void
+fribidi_allocator_arena_destroy(FriBidiAllocator *allocator)
+{
+  Arena *arena = (Arena*)allocator;
+  ArenaBlock *block = arena->blocks;
+
+  while (block)
+    {
+      ArenaBlock *next = block->next;
+      g_free(block);
+      block = next;
+    }
+  g_free(arena);
+}
+
+/*======================================================================
+//  Contexts. The context used by the plain fribidi_log2vis() calls is
+//  a static one using glib, or malloc if USE_SIMPLE_MALLOC is defined.
+//  USE_SIMPLE_MALLOC also turns off the pooling of links.
+//----------------------------------------------------------------------*/
+#ifdef USE_SIMPLE_MALLOC
+#define DEFAULT_ALLOCATOR &fribidi_allocator_malloc
+#define DEFAULT_POOL_LIMIT 0
+#else
+#define DEFAULT_ALLOCATOR &fribidi_allocator_glib
+#define DEFAULT_POOL_LIMIT FRIBIDI_POOL_LIMIT
+#endif
+
+static FriBidiContext default_context = {
+  DEFAULT_ALLOCATOR,
+  NULL,
+  0,
+  DEFAULT_POOL_LIMIT,
+  { 0, 0, 0 }
+};
+
+FriBidiContext *
+fribidi_default_context(void)
+{
+  return &default_context;
+}
+
+FriBidiContext *
+fribidi_context_new(FriBidiAllocator *allocator)
+{
+  FriBidiContext *ctx = g_new(FriBidiContext, 1);
+
+  ctx->allocator = allocator ? allocator : DEFAULT_ALLOCATOR;
+  ctx->free_type_links = NULL;
+  ctx->num_free_type_links = 0;
+  ctx->pool_limit = DEFAULT_POOL_LIMIT;
+  ctx->stats.bytes_in_use = 0;
+  ctx->stats.bytes_pooled = 0;
+  ctx->stats.peak_bytes = 0;
+  fribidi_context_reset_stats(ctx);
+  return ctx;
+}
+
+/* Give the pooled links back to the allocator */
+static void free_type_link_pool(FriBidiContext *ctx)
+{
+  TypeLink *link = ctx->free_type_links;
+
+  while (link)
+    {
+      TypeLink *next = link->next;
+      ctx->allocator->free(link, ctx->allocator->user_data);
+      link = next;
+    }
+  ctx->free_type_links = NULL;
+  ctx->num_free_type_links = 0;
+  ctx->stats.bytes_pooled = 0;
+}
+
+/*======================================================================
+//  fribidi_context_reset() should be called when the memory of the
+//  allocator is about to be released wholesale, e.g. at the end of a
+//  request. It forgets the links pooled in that memory and then calls
+//  the reset function of the allocator.
+//----------------------------------------------------------------------*/
+void
+fribidi_context_reset(FriBidiContext *ctx)
+{
+  if (ctx->allocator->reset)
+    {
+      ctx->free_type_links = NULL;
+      ctx->num_free_type_links = 0;
+      ctx->stats.bytes_pooled = 0;
+      ctx->stats.bytes_in_use = 0;
+      ctx->allocator->reset(ctx->allocator->user_data);
+    }
+  else
+    free_type_link_pool(ctx);
+}
+
+/* The memory of an allocator that has a reset function is left to
+   the owner of the allocator. */
+void
+fribidi_context_destroy(FriBidiContext *ctx)
+{
+  if (!ctx->allocator->reset)
+    free_type_link_pool(ctx);
+  g_free(ctx);
+}
+
+/*======================================================================
+//  Memory statistics and limits. The pool limit is the number of
+//  bytes of released links that are kept for reuse. Links released
+//  beyond the limit are given back to the allocator.
+//----------------------------------------------------------------------*/
+void
+fribidi_context_set_memory_pool_limit(FriBidiContext *ctx,
+				      gsize max_pooled_bytes)
+{
+  ctx->pool_limit = max_pooled_bytes / sizeof(TypeLink);
+
+  /* Shrink the pool down to the new limit */
+  while (ctx->num_free_type_links > ctx->pool_limit)
+    {
+      TypeLink *link = ctx->free_type_links;
+      ctx->free_type_links = link->next;
+      ctx->num_free_type_links--;
+      ctx->stats.bytes_pooled -= sizeof(TypeLink);
+      ctx->allocator->free(link, ctx->allocator->user_data);
+    }
+}
+
+void
+fribidi_context_trim_memory(FriBidiContext *ctx)
+{
+  free_type_link_pool(ctx);
+}
+
+void
+fribidi_context_get_memory_stats(FriBidiContext *ctx,
+				 /* output */
+				 FriBidiMemoryStats *stats)
+{
+  *stats = ctx->stats;
+}
+
+void
+fribidi_set_memory_pool_limit(gsize max_pooled_bytes)
+{
+  fribidi_context_set_memory_pool_limit(&default_context, max_pooled_bytes);
+}
+
+void
+fribidi_trim_memory(void)
+{
+  fribidi_context_trim_memory(&default_context);
+}
+
+void
+fribidi_get_memory_stats(/* output */
+			 FriBidiMemoryStats *stats)
+{
+  fribidi_context_get_memory_stats(&default_context, stats);
+}
+
+#define UPDATE_PEAK(ctx)						\
+  if ((ctx)->stats.bytes_in_use + (ctx)->stats.bytes_pooled		\
+      > (ctx)->stats.peak_bytes)					\
+    (ctx)->stats.peak_bytes = (ctx)->stats.bytes_in_use		\
+			      + (ctx)->stats.bytes_pooled
+
+gpointer
+fribidi_context_alloc(FriBidiContext *ctx,
+		      gsize size)
+{
+  ctx->stats.bytes_in_use += size;
+  UPDATE_PEAK(ctx);
+  return ctx->allocator->alloc(size, ctx->allocator->user_data);
+}
+
+void
+fribidi_context_free(FriBidiContext *ctx,
+		     gpointer mem,
+		     gsize size)
+{
+  ctx->stats.bytes_in_use -= size;
+  ctx->allocator->free(mem, ctx->allocator->user_data);
+}
+
+/*======================================================================
+//  The pool of type links. Links that are freed are kept on a free
+//  list of the context and reused by later calls, up to the pool
+//  limit of the context.
+//----------------------------------------------------------------------*/
+TypeLink *
+fribidi_type_link_new(FriBidiContext *ctx)
+{
+  TypeLink *link;
+
+  if (ctx->free_type_links)
+    {
+      link = ctx->free_type_links;
+      ctx->free_type_links = link->next;
+      ctx->num_free_type_links--;
+      ctx->stats.bytes_pooled -= sizeof(TypeLink);
+      ctx->stats.bytes_in_use += sizeof(TypeLink);
+    }
+  else
+    link = fribidi_context_alloc(ctx, sizeof(TypeLink));
+
+  link->len = 0;
+  link->pos = 0;
+  link->level = 0;
+  link->next = NULL;
+  link->prev = NULL;
+  return link;
+}
+
+void
+fribidi_type_link_free(FriBidiContext *ctx,
+		       TypeLink *link)
+{
+  if (ctx->num_free_type_links < ctx->pool_limit)
+    {
+      link->next = ctx->free_type_links;
+      ctx->free_type_links = link;
+      ctx->num_free_type_links++;
+      ctx->stats.bytes_pooled += sizeof(TypeLink);
+      ctx->stats.bytes_in_use -= sizeof(TypeLink);
+    }
+  else
+    fribidi_context_free(ctx, link, sizeof(TypeLink));
+}
+
+/* Free all the links in a list linked by the next pointers */
+void
+fribidi_type_link_list_free(FriBidiContext *ctx,
+			    TypeLink *list)
+{
+  while (list)
+    {
+      TypeLink *next = list->next;
+      fribidi_type_link_free(ctx, list);
+      list = next;
+    }
+}
@@ -0,0 +1,178 @@
+/* FriBidi - Library of BiDi algorithm
+ * Copyright (C) 1999 Dov Grobgeld
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*======================================================================
+//  Declarations that are shared between the source files of the
+//  library but that are not part of the public interface. This file
+//  is not installed.
+//----------------------------------------------------------------------*/
+#ifndef FRIBIDI_PRIVATE_H
+#define FRIBIDI_PRIVATE_H
+
+#include "fribidi.h"
+#include "fribidi_trace.h"
+
+/* The vector kernels are built for x86 with gcc, unless FRIBIDI_NO_SIMD
+   is defined. */
+#if defined(__GNUC__) && defined(__SSE2__) \
+    && (defined(__x86_64__) || defined(__i386__)) \
+    && !defined(FRIBIDI_NO_SIMD)
+#define FRIBIDI_X86_SIMD
+#endif
+
+/*======================================================================
+// Typedef for the run-length list.
+//----------------------------------------------------------------------*/
+typedef struct _TypeLink TypeLink;
+
+struct _TypeLink {
+  TypeLink *prev;
+  TypeLink *next;
+  FriBidiCharType type;
+  gint pos;
+  gint len;
+  gint level;
+};
+
+struct _FriBidiContext {
+  FriBidiAllocator *allocator;
+
+  /* Pool of type links that have been released by previous calls */
+  TypeLink *free_type_links;
+  gsize num_free_type_links;
+  gsize pool_limit;            /* In links */
+
+  FriBidiMemoryStats stats;
+#ifdef FRIBIDI_ENABLE_STATS
+  FriBidiStats engine_stats;
+#endif
+};
+
+/*======================================================================
+//  With FRIBIDI_ENABLE_STATS the engine times its phases and counts
+//  its work in the engine_stats of the context. Otherwise the macros
+//  expand to nothing. A timer is declared last among the declarations
+//  of a function, without a semicolon, and each lap adds the time
+//  since the last one to a phase:
+//
+//     STATS_TIMER(t)
+//     ...
+//     STATS_LAP(ctx, t, FRIBIDI_PHASE_WEAK);
+//
+//  STATS_RESTART() skips time that is counted by the functions that
+//  are called.
+//----------------------------------------------------------------------*/
+#ifdef FRIBIDI_ENABLE_STATS
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FRIBIDI_CYCLES() __builtin_ia32_rdtsc()
+#else
+#define FRIBIDI_CYCLES() fribidi_cycles()
+#endif
+
+#define STATS_TIMER(t) guint64 t = FRIBIDI_CYCLES();
+#define STATS_RESTART(t) ((t) = FRIBIDI_CYCLES())
+#define STATS_LAP(ctx, t, phase)					\
+  do {									\
+    guint64 now_ = FRIBIDI_CYCLES();					\
+    (ctx)->engine_stats.phase_cycles[phase] += now_ - (t);		\
+    (t) = now_;								\
+  } while (0)
+#define STATS_ADD(ctx, counter, n) ((ctx)->engine_stats.counter += (n))
+#else
+#define STATS_TIMER(t)
+#define STATS_RESTART(t)
+#define STATS_LAP(ctx, t, phase)
+#define STATS_ADD(ctx, counter, n)
+#endif
+
+/*======================================================================
+//  With FRIBIDI_ENABLE_TRACE the engine records events for the threads
+//  that have turned tracing on. TRACE() runs its statement only then,
+//  and without FRIBIDI_ENABLE_TRACE it expands to nothing, so the
+//  engine has no check left.
+//----------------------------------------------------------------------*/
+#ifdef FRIBIDI_ENABLE_TRACE
+extern __thread gboolean fribidi_tracing;
+
+/* fribidi_trace.c */
+void fribidi_trace_record(gint kind,
+			  gint arg,
+			  gint32 v0,
+			  gint32 v1,
+			  gint32 v2);
+
+#define TRACE(statement)						\
+  do {									\
+    if (fribidi_tracing)						\
+      {									\
+	statement;							\
+      }									\
+  } while (0)
+#else
+#define TRACE(statement)
+#endif
+
+#define TRACE_PHASE(phase)						\
+  TRACE(fribidi_trace_record(FRIBIDI_TRACE_PHASE, (phase), 0, 0, 0))
+
+/* fribidi_mem.c */
+FriBidiContext *fribidi_default_context(void);
+
+gpointer fribidi_context_alloc(FriBidiContext *ctx,
+			       gsize size);
+void     fribidi_context_free(FriBidiContext *ctx,
+			      gpointer mem,
+			      gsize size);
+
+TypeLink *fribidi_type_link_new(FriBidiContext *ctx);
+void      fribidi_type_link_free(FriBidiContext *ctx,
+				 TypeLink *link);
+void      fribidi_type_link_list_free(FriBidiContext *ctx,
+				      TypeLink *list);
+
+/* fribidi_simd.c */
+gboolean fribidi_cpu_has_avx2(void);
+
+void fribidi_reverse_u32(guint32 *arr, gint len);
+void fribidi_reverse_u16(guint16 *arr, gint len);
+
+void fribidi_expand_bits_u8(guint64 *bits, gint len, guint8 *out);
+
+/* The bytes that the ASCII kernel takes at a time */
+#define FRIBIDI_UTF8_ASCII_BLOCK 16
+
+typedef gint (*FriBidiAsciiPrefixFunc)(guchar *s, gint len, FriBidiChar *us);
+
+FriBidiAsciiPrefixFunc fribidi_utf8_ascii_prefix_kernel(void);
+gint fribidi_utf8_count_bytes(FriBidiChar *us, gint len);
+gint fribidi_utf8_encode_prefix(FriBidiChar *us, gint len, guchar *s, gint size,
+				gint *bytes);
+
+void fribidi_8bit_to_unicode(const FriBidiChar *table, guchar *s, gint len,
+			     FriBidiChar *us);
+void fribidi_unicode_to_8bit(const gint32 *index, const guint8 *pages,
+			     FriBidiChar *us, gint len, guchar *s);
+
+/* fribidi_stats.c */
+guint64 fribidi_cycles(void);
+
+/* fribidi_char_sets.c */
+gint fribidi_utf8_decode_char(guchar *s, gint len, FriBidiChar *ch);
+
+#endif /* FRIBIDI_PRIVATE_H */
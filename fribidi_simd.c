@@ -0,0 +1,717 @@
+/* FriBidi - Library of BiDi algorithm
+ * Copyright (C) 1999 Dov Grobgeld
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*======================================================================
+//  This file contains the vectorised kernels of the library and the
+//  run time selection between them. Every kernel has a plain C
+//  version that is used when the processor, or the compiler, doesn't
+//  support the vector instructions.
+//----------------------------------------------------------------------*/
+
+#include <glib.h>
+#include "fribidi_private.h"
+
+#ifdef FRIBIDI_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/* The kernels are selected on their first use. Threads that race to
+   select them store the same values. */
+#ifdef __GNUC__
+#define KERNEL_LOAD(p) __atomic_load_n(&(p), __ATOMIC_ACQUIRE)
+#define KERNEL_STORE(p, v) __atomic_store_n(&(p), (v), __ATOMIC_RELEASE)
+#else
+#define KERNEL_LOAD(p) (p)
+#define KERNEL_STORE(p, v) ((p) = (v))
+#endif
+
+/*======================================================================
+//  Processor feature detection. SSE2 is assumed whenever the compiler
+//  targets it; AVX2 is checked for at run time.
+//----------------------------------------------------------------------*/
+gboolean
+fribidi_cpu_has_avx2(void)
+{
+#ifdef FRIBIDI_X86_SIMD
+  static gint has_avx2 = -1;
+
+  if (KERNEL_LOAD(has_avx2) < 0)
+    {
+      __builtin_cpu_init();
+      KERNEL_STORE(has_avx2, __builtin_cpu_supports("avx2") ? 1 : 0);
+    }
+  return KERNEL_LOAD(has_avx2);
+#else
+  return FALSE;
+#endif
+}
+
+/*======================================================================
+//  Reversal of runs of 32 and 16 bit elements. The vector versions
+//  swap a block from each end of the run per iteration and leave the
+//  middle of the run, which is shorter than two blocks, to the plain
+//  version.
+//----------------------------------------------------------------------*/
+static void
+reverse_u32_c(guint32 *lo, guint32 *hi)
+{
+  while (lo < --hi)
+    {
+      guint32 tmp = *lo;
+      *lo++ = *hi;
+      *hi = tmp;
+    }
+}
+
+static void
+reverse_u16_c(guint16 *lo, guint16 *hi)
+{
+  while (lo < --hi)
+    {
+      guint16 tmp = *lo;
+      *lo++ = *hi;
+      *hi = tmp;
+    }
+}
+
+#ifdef FRIBIDI_X86_SIMD
+static void
+reverse_u32_sse2(guint32 *arr, gint len)
+{
+  guint32 *lo = arr, *hi = arr + len;
+
+  while (hi - lo >= 8)
+    {
+      __m128i a = _mm_loadu_si128((__m128i*)lo);
+      __m128i b = _mm_loadu_si128((__m128i*)(hi - 4));
+      _mm_storeu_si128((__m128i*)lo, _mm_shuffle_epi32(b, 0x1B));
+      _mm_storeu_si128((__m128i*)(hi - 4), _mm_shuffle_epi32(a, 0x1B));
+      lo += 4;
+      hi -= 4;
+    }
+  reverse_u32_c(lo, hi);
+}
+
+static inline __m128i
+reverse_epi16(__m128i x)
+{
+  x = _mm_shufflelo_epi16(x, 0x1B);
+  x = _mm_shufflehi_epi16(x, 0x1B);
+  return _mm_shuffle_epi32(x, 0x4E);
+}
+
+static void
+reverse_u16_sse2(guint16 *arr, gint len)
+{
+  guint16 *lo = arr, *hi = arr + len;
+
+  while (hi - lo >= 16)
+    {
+      __m128i a = _mm_loadu_si128((__m128i*)lo);
+      __m128i b = _mm_loadu_si128((__m128i*)(hi - 8));
+      _mm_storeu_si128((__m128i*)lo, reverse_epi16(b));
+      _mm_storeu_si128((__m128i*)(hi - 8), reverse_epi16(a));
+      lo += 8;
+      hi -= 8;
+    }
+  reverse_u16_c(lo, hi);
+}
+
+__attribute__((target("avx2")))
+static void
+reverse_u32_avx2(guint32 *arr, gint len)
+{
+  guint32 *lo = arr, *hi = arr + len;
+  __m256i idx = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+
+  while (hi - lo >= 16)
+    {
+      __m256i a = _mm256_loadu_si256((__m256i*)lo);
+      __m256i b = _mm256_loadu_si256((__m256i*)(hi - 8));
+      _mm256_storeu_si256((__m256i*)lo, _mm256_permutevar8x32_epi32(b, idx));
+      _mm256_storeu_si256((__m256i*)(hi - 8), _mm256_permutevar8x32_epi32(a, idx));
+      lo += 8;
+      hi -= 8;
+    }
+  /* Clean the upper halves before the SSE2 code, or every SSE2
+     instruction pays for the transition */
+  _mm256_zeroupper();
+  reverse_u32_sse2(lo, hi - lo);
+}
+
+__attribute__((target("avx2")))
+static void
+reverse_u16_avx2(guint16 *arr, gint len)
+{
+  guint16 *lo = arr, *hi = arr + len;
+  /* Reverse the words within each 128 bit lane, then swap the lanes */
+  __m256i idx = _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9,
+				 6, 7, 4, 5, 2, 3, 0, 1,
+				 14, 15, 12, 13, 10, 11, 8, 9,
+				 6, 7, 4, 5, 2, 3, 0, 1);
+
+  while (hi - lo >= 32)
+    {
+      __m256i a = _mm256_loadu_si256((__m256i*)lo);
+      __m256i b = _mm256_loadu_si256((__m256i*)(hi - 16));
+      a = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(a, idx), 0x4E);
+      b = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(b, idx), 0x4E);
+      _mm256_storeu_si256((__m256i*)lo, b);
+      _mm256_storeu_si256((__m256i*)(hi - 16), a);
+      lo += 16;
+      hi -= 16;
+    }
+  _mm256_zeroupper();
+  reverse_u16_sse2(lo, hi - lo);
+}
+#endif
+
+static void
+reverse_u32_plain(guint32 *arr, gint len)
+{
+  reverse_u32_c(arr, arr + len);
+}
+
+static void
+reverse_u16_plain(guint16 *arr, gint len)
+{
+  reverse_u16_c(arr, arr + len);
+}
+
+static void (*reverse_u32_impl)(guint32 *arr, gint len) = NULL;
+static void (*reverse_u16_impl)(guint16 *arr, gint len) = NULL;
+
+static void
+select_reverse_kernels(void)
+{
+#ifdef FRIBIDI_X86_SIMD
+  if (fribidi_cpu_has_avx2())
+    {
+      KERNEL_STORE(reverse_u16_impl, reverse_u16_avx2);
+      KERNEL_STORE(reverse_u32_impl, reverse_u32_avx2);
+    }
+  else
+    {
+      KERNEL_STORE(reverse_u16_impl, reverse_u16_sse2);
+      KERNEL_STORE(reverse_u32_impl, reverse_u32_sse2);
+    }
+#else
+  KERNEL_STORE(reverse_u16_impl, reverse_u16_plain);
+  KERNEL_STORE(reverse_u32_impl, reverse_u32_plain);
+#endif
+}
+
+/* Runs this short are reversed faster than the kernel is called */
+#define SHORT_REVERSAL 8
+
+void
+fribidi_reverse_u32(guint32 *arr, gint len)
+{
+  if (len < SHORT_REVERSAL)
+    reverse_u32_plain(arr, len);
+  else
+    {
+      if (!KERNEL_LOAD(reverse_u32_impl))
+	select_reverse_kernels();
+      KERNEL_LOAD(reverse_u32_impl)(arr, len);
+    }
+}
+
+void
+fribidi_reverse_u16(guint16 *arr, gint len)
+{
+  if (len < SHORT_REVERSAL)
+    reverse_u16_plain(arr, len);
+  else
+    {
+      if (!KERNEL_LOAD(reverse_u16_impl))
+	select_reverse_kernels();
+      KERNEL_LOAD(reverse_u16_impl)(arr, len);
+    }
+}
+
+/*======================================================================
+//  Expansion of a bit mask to one byte of 0 or 1 per bit. The vector
+//  version spreads each byte of the mask over eight bytes and tests
+//  one bit in each of them.
+//----------------------------------------------------------------------*/
+void
+fribidi_expand_bits_u8(guint64 *bits, gint len, guint8 *out)
+{
+  gint i = 0;
+
+#ifdef FRIBIDI_X86_SIMD
+  const __m128i sel = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128,
+				    1, 2, 4, 8, 16, 32, 64, -128);
+  const __m128i one = _mm_set1_epi8(1);
+  const guint64 spread = G_GINT64_CONSTANT(0x0101010101010101);
+
+  for (; i + 16 <= len; i += 16)
+    {
+      guint64 lo = (bits[i / 64] >> (i % 64)) & 0xff;
+      guint64 hi = (bits[i / 64] >> (i % 64 + 8)) & 0xff;
+      __m128i x = _mm_set_epi64x((gint64)(hi * spread), (gint64)(lo * spread));
+
+      x = _mm_cmpeq_epi8(_mm_and_si128(x, sel), sel);
+      _mm_storeu_si128((__m128i*)(out + i), _mm_and_si128(x, one));
+    }
+#endif
+
+  for (; i<len; i++)
+    out[i] = (bits[i / 64] >> (i % 64)) & 1;
+}
+
+/*======================================================================
+//  The ASCII fast path of the UTF-8 decoder. The kernel that
+//  fribidi_utf8_ascii_prefix_kernel() gives widens the bytes of s to
+//  characters for as long as whole blocks of FRIBIDI_UTF8_ASCII_BLOCK
+//  of them are ASCII, and returns the number of bytes that it decoded.
+//  The rest, from the first block that has a byte above 0x7F, is left
+//  to the caller. Without vector kernels there is none, and the
+//  function returns NULL.
+//----------------------------------------------------------------------*/
+#ifdef FRIBIDI_X86_SIMD
+static gint
+utf8_ascii_prefix_sse2(guchar *s, gint len, FriBidiChar *us)
+{
+  const __m128i zero = _mm_setzero_si128();
+  gint i = 0;
+
+  for (; i + 16 <= len; i += 16)
+    {
+      __m128i x = _mm_loadu_si128((__m128i*)(s + i));
+      __m128i lo, hi;
+
+      if (_mm_movemask_epi8(x))
+	break;
+      lo = _mm_unpacklo_epi8(x, zero);
+      hi = _mm_unpackhi_epi8(x, zero);
+      _mm_storeu_si128((__m128i*)(us + i), _mm_unpacklo_epi16(lo, zero));
+      _mm_storeu_si128((__m128i*)(us + i + 4), _mm_unpackhi_epi16(lo, zero));
+      _mm_storeu_si128((__m128i*)(us + i + 8), _mm_unpacklo_epi16(hi, zero));
+      _mm_storeu_si128((__m128i*)(us + i + 12), _mm_unpackhi_epi16(hi, zero));
+    }
+  return i;
+}
+
+__attribute__((target("avx2")))
+static gint
+utf8_ascii_prefix_avx2(guchar *s, gint len, FriBidiChar *us)
+{
+  gint i = 0;
+
+  for (; i + 32 <= len; i += 32)
+    {
+      __m256i x = _mm256_loadu_si256((__m256i*)(s + i));
+
+      if (_mm256_movemask_epi8(x))
+	break;
+      _mm256_storeu_si256((__m256i*)(us + i),
+			  _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)(s + i))));
+      _mm256_storeu_si256((__m256i*)(us + i + 8),
+			  _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)(s + i + 8))));
+      _mm256_storeu_si256((__m256i*)(us + i + 16),
+			  _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)(s + i + 16))));
+      _mm256_storeu_si256((__m256i*)(us + i + 24),
+			  _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)(s + i + 24))));
+    }
+  _mm256_zeroupper();
+  return i + utf8_ascii_prefix_sse2(s + i, len - i, us + i);
+}
+#endif
+
+static FriBidiAsciiPrefixFunc utf8_ascii_prefix_impl = NULL;
+
+FriBidiAsciiPrefixFunc
+fribidi_utf8_ascii_prefix_kernel(void)
+{
+#ifdef FRIBIDI_X86_SIMD
+  if (!KERNEL_LOAD(utf8_ascii_prefix_impl))
+    {
+      if (fribidi_cpu_has_avx2())
+	KERNEL_STORE(utf8_ascii_prefix_impl, utf8_ascii_prefix_avx2);
+      else
+	KERNEL_STORE(utf8_ascii_prefix_impl, utf8_ascii_prefix_sse2);
+    }
+#endif
+  return KERNEL_LOAD(utf8_ascii_prefix_impl);
+}
+
+/*======================================================================
+//  The UTF-8 encoder kernels. fribidi_utf8_count_bytes() gives the
+//  encoded length of a string, counting U+FFFD for characters that
+//  have no UTF-8 form. fribidi_utf8_encode_prefix() encodes blocks of
+//  eight characters for as long as each block is all ASCII or all two
+//  byte forms, or, with AVX2, any mix of the two, and there is room
+//  for sixteen bytes. It returns the number of characters encoded and
+//  gives the number of bytes in *bytes. The rest is left to the
+//  caller.
+//----------------------------------------------------------------------*/
+static gint
+utf8_count_bytes_plain(FriBidiChar *us, gint len)
+{
+  gint i, n = len;
+
+  for (i=0; i<len; i++)
+    {
+      FriBidiChar ch = us[i];
+      n += (ch > 0x7F) + (ch > 0x7FF) + (ch > 0xFFFF) - (ch > 0x10FFFF);
+    }
+  return n;
+}
+
+#ifdef FRIBIDI_X86_SIMD
+/* The comparisons are signed, so both sides are biased by 2^31 */
+#define SIGN_BIAS ((gint)0x80000000U)
+
+static gint
+utf8_count_bytes_sse2(FriBidiChar *us, gint len)
+{
+  const __m128i bias = _mm_set1_epi32(SIGN_BIAS);
+  const __m128i k1 = _mm_set1_epi32(0x7F ^ SIGN_BIAS);
+  const __m128i k2 = _mm_set1_epi32(0x7FF ^ SIGN_BIAS);
+  const __m128i k3 = _mm_set1_epi32(0xFFFF ^ SIGN_BIAS);
+  const __m128i k4 = _mm_set1_epi32(0x10FFFF ^ SIGN_BIAS);
+  __m128i acc = _mm_setzero_si128();
+  gint32 sum[4];
+  gint i = 0;
+
+  for (; i + 4 <= len; i += 4)
+    {
+      __m128i x = _mm_xor_si128(_mm_loadu_si128((__m128i*)(us + i)), bias);
+
+      acc = _mm_sub_epi32(acc, _mm_cmpgt_epi32(x, k1));
+      acc = _mm_sub_epi32(acc, _mm_cmpgt_epi32(x, k2));
+      acc = _mm_sub_epi32(acc, _mm_cmpgt_epi32(x, k3));
+      acc = _mm_add_epi32(acc, _mm_cmpgt_epi32(x, k4));
+    }
+  _mm_storeu_si128((__m128i*)sum, acc);
+  return i + sum[0] + sum[1] + sum[2] + sum[3]
+    + utf8_count_bytes_plain(us + i, len - i);
+}
+
+__attribute__((target("avx2")))
+static gint
+utf8_count_bytes_avx2(FriBidiChar *us, gint len)
+{
+  const __m256i bias = _mm256_set1_epi32(SIGN_BIAS);
+  const __m256i k1 = _mm256_set1_epi32(0x7F ^ SIGN_BIAS);
+  const __m256i k2 = _mm256_set1_epi32(0x7FF ^ SIGN_BIAS);
+  const __m256i k3 = _mm256_set1_epi32(0xFFFF ^ SIGN_BIAS);
+  const __m256i k4 = _mm256_set1_epi32(0x10FFFF ^ SIGN_BIAS);
+  __m256i acc = _mm256_setzero_si256();
+  gint32 sum[8];
+  gint i = 0, n, k;
+
+  for (; i + 8 <= len; i += 8)
+    {
+      __m256i x = _mm256_xor_si256(_mm256_loadu_si256((__m256i*)(us + i)), bias);
+
+      acc = _mm256_sub_epi32(acc, _mm256_cmpgt_epi32(x, k1));
+      acc = _mm256_sub_epi32(acc, _mm256_cmpgt_epi32(x, k2));
+      acc = _mm256_sub_epi32(acc, _mm256_cmpgt_epi32(x, k3));
+      acc = _mm256_add_epi32(acc, _mm256_cmpgt_epi32(x, k4));
+    }
+  _mm256_storeu_si256((__m256i*)sum, acc);
+  n = i;
+  for (k=0; k<8; k++)
+    n += sum[k];
+  return n + utf8_count_bytes_plain(us + i, len - i);
+}
+
+#undef SIGN_BIAS
+
+/* Load eight characters and tell whether they are all ASCII, or all
+   below U+0800. The latter are packed to 16 bits in *c. */
+#define UTF8_BLOCK_ASCII 1
+#define UTF8_BLOCK_2BYTE 2
+
+static inline gint
+utf8_classify_block(FriBidiChar *us, __m128i *c)
+{
+  const __m128i zero = _mm_setzero_si128();
+  __m128i a = _mm_loadu_si128((__m128i*)us);
+  __m128i b = _mm_loadu_si128((__m128i*)(us + 4));
+  __m128i ab = _mm_or_si128(a, b);
+
+  if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(ab, _mm_set1_epi32(~0x7FF)),
+					zero)) != 0xFFFF)
+    return 0;
+  *c = _mm_packs_epi32(a, b);
+  if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(ab, _mm_set1_epi32(~0x7F)),
+					zero)) == 0xFFFF)
+    return UTF8_BLOCK_ASCII;
+  return UTF8_BLOCK_2BYTE;
+}
+
+/* Both bytes of the two byte forms of the 16 bit characters in c */
+static inline __m128i
+utf8_2byte_forms(__m128i c)
+{
+  return _mm_or_si128(_mm_or_si128(_mm_srli_epi16(c, 6),
+				   _mm_slli_epi16(_mm_and_si128(c, _mm_set1_epi16(0x3F)), 8)),
+		      _mm_set1_epi16((gshort)0x80C0));
+}
+
+static gint
+utf8_encode_prefix_sse2(FriBidiChar *us, gint len, guchar *s, gint size,
+			gint *bytes)
+{
+  const __m128i max_ascii = _mm_set1_epi16(0x7F);
+  gint i = 0, j = 0;
+
+  while (i + 8 <= len && j + 16 <= size)
+    {
+      __m128i c;
+      gint kind = utf8_classify_block(us + i, &c);
+
+      if (kind == UTF8_BLOCK_ASCII)
+	{
+	  _mm_storel_epi64((__m128i*)(s + j), _mm_packus_epi16(c, c));
+	  j += 8;
+	}
+      else if (kind == UTF8_BLOCK_2BYTE
+	       && _mm_movemask_epi8(_mm_cmpgt_epi16(c, max_ascii)) == 0xFFFF)
+	{
+	  _mm_storeu_si128((__m128i*)(s + j), utf8_2byte_forms(c));
+	  j += 16;
+	}
+      else
+	break;
+      i += 8;
+    }
+  *bytes = j;
+  return i;
+}
+
+/* For each mask of the ASCII characters of a block, the shuffle that
+   drops the unused high byte of their 16 bit forms */
+#include "fribidi_simd_tables.i"
+
+__attribute__((target("avx2")))
+static gint
+utf8_encode_prefix_avx2(FriBidiChar *us, gint len, guchar *s, gint size,
+			gint *bytes)
+{
+  const __m128i min_2byte = _mm_set1_epi16(0x80);
+  gint i = 0, j = 0;
+
+  while (i + 8 <= len && j + 16 <= size)
+    {
+      __m128i c, is_ascii, w;
+      gint kind = utf8_classify_block(us + i, &c);
+      gint mask;
+
+      if (kind == UTF8_BLOCK_ASCII)
+	{
+	  _mm_storel_epi64((__m128i*)(s + j), _mm_packus_epi16(c, c));
+	  j += 8;
+	}
+      else if (kind == UTF8_BLOCK_2BYTE)
+	{
+	  is_ascii = _mm_cmplt_epi16(c, min_2byte);
+	  w = _mm_blendv_epi8(utf8_2byte_forms(c), c, is_ascii);
+	  mask = _mm_movemask_epi8(_mm_packs_epi16(is_ascii, is_ascii)) & 0xFF;
+	  w = _mm_shuffle_epi8(w, _mm_loadu_si128((__m128i*)utf8_compact_shuffle[mask]));
+	  _mm_storeu_si128((__m128i*)(s + j), w);
+	  j += 16 - __builtin_popcount(mask);
+	}
+      else
+	break;
+      i += 8;
+    }
+  *bytes = j;
+  return i;
+}
+#endif
+
+#ifndef FRIBIDI_X86_SIMD
+static gint
+utf8_encode_prefix_plain(FriBidiChar *us, gint len, guchar *s, gint size,
+			 gint *bytes)
+{
+  *bytes = 0;
+  return 0;
+}
+#endif
+
+static gint (*utf8_count_bytes_impl)(FriBidiChar *us, gint len) = NULL;
+static gint (*utf8_encode_prefix_impl)(FriBidiChar *us, gint len, guchar *s,
+				       gint size, gint *bytes) = NULL;
+
+static void
+select_utf8_encode_kernels(void)
+{
+#ifdef FRIBIDI_X86_SIMD
+  if (fribidi_cpu_has_avx2())
+    {
+      KERNEL_STORE(utf8_encode_prefix_impl, utf8_encode_prefix_avx2);
+      KERNEL_STORE(utf8_count_bytes_impl, utf8_count_bytes_avx2);
+    }
+  else
+    {
+      KERNEL_STORE(utf8_encode_prefix_impl, utf8_encode_prefix_sse2);
+      KERNEL_STORE(utf8_count_bytes_impl, utf8_count_bytes_sse2);
+    }
+#else
+  KERNEL_STORE(utf8_encode_prefix_impl, utf8_encode_prefix_plain);
+  KERNEL_STORE(utf8_count_bytes_impl, utf8_count_bytes_plain);
+#endif
+}
+
+gint
+fribidi_utf8_count_bytes(FriBidiChar *us, gint len)
+{
+  if (!KERNEL_LOAD(utf8_count_bytes_impl))
+    select_utf8_encode_kernels();
+  return KERNEL_LOAD(utf8_count_bytes_impl)(us, len);
+}
+
+gint
+fribidi_utf8_encode_prefix(FriBidiChar *us, gint len, guchar *s, gint size,
+			   gint *bytes)
+{
+  if (!KERNEL_LOAD(utf8_encode_prefix_impl))
+    select_utf8_encode_kernels();
+  return KERNEL_LOAD(utf8_encode_prefix_impl)(us, len, s, size, bytes);
+}
+
+/*======================================================================
+//  Conversion of whole strings of an 8-bit character set through the
+//  tables of fribidi_char_sets_tables.i. To Unicode, each byte is
+//  looked up in a table of 256 characters. From Unicode, the high byte
+//  of a character selects the offset of a page of 256 bytes in the
+//  index, and the low byte the entry in the page. Page 0 maps
+//  everything to the byte of unknown characters, and is used for the
+//  characters beyond the Basic Multilingual Plane. With AVX2, eight
+//  lookups are done at a time with gathers; the pages are padded to be
+//  read four bytes at a time.
+//----------------------------------------------------------------------*/
+static void
+to_unicode_8bit_plain(const FriBidiChar *table, guchar *s, gint len,
+		      FriBidiChar *us)
+{
+  gint i;
+
+  for (i=0; i<len; i++)
+    us[i] = table[s[i]];
+}
+
+static void
+from_unicode_8bit_plain(const gint32 *index, const guint8 *pages,
+			FriBidiChar *us, gint len, guchar *s)
+{
+  gint i;
+
+  for (i=0; i<len; i++)
+    {
+      FriBidiChar uch = us[i];
+      s[i] = (uch < 0x10000) ? pages[index[uch >> 8] + (uch & 0xFF)] : pages[0];
+    }
+}
+
+#ifdef FRIBIDI_X86_SIMD
+__attribute__((target("avx2")))
+static void
+to_unicode_8bit_avx2(const FriBidiChar *table, guchar *s, gint len,
+		     FriBidiChar *us)
+{
+  gint i = 0;
+
+  for (; i + 8 <= len; i += 8)
+    {
+      __m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)(s + i)));
+
+      _mm256_storeu_si256((__m256i*)(us + i),
+			  _mm256_i32gather_epi32((const int*)table, idx, 4));
+    }
+  to_unicode_8bit_plain(table, s + i, len - i, us + i);
+}
+
+__attribute__((target("avx2")))
+static void
+from_unicode_8bit_avx2(const gint32 *index, const guint8 *pages,
+		       FriBidiChar *us, gint len, guchar *s)
+{
+  const __m256i low_byte = _mm256_set1_epi32(0xFF);
+  const __m256i first_bytes = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1,
+					       -1, -1, -1, -1, -1, -1, -1, -1,
+					       0, 4, 8, 12, -1, -1, -1, -1,
+					       -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m256i join_lanes = _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1);
+  gint i = 0;
+
+  for (; i + 8 <= len; i += 8)
+    {
+      __m256i x = _mm256_loadu_si256((__m256i*)(us + i));
+      __m256i in_bmp = _mm256_cmpeq_epi32(_mm256_srli_epi32(x, 16),
+					  _mm256_setzero_si256());
+      __m256i hi = _mm256_and_si256(_mm256_srli_epi32(x, 8), low_byte);
+      __m256i off = _mm256_i32gather_epi32((const int*)index, hi, 4);
+      __m256i b;
+
+      off = _mm256_add_epi32(off, _mm256_and_si256(x, low_byte));
+      off = _mm256_and_si256(off, in_bmp);
+      b = _mm256_i32gather_epi32((const int*)pages, off, 1);
+      b = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(b, first_bytes),
+				      join_lanes);
+      _mm_storel_epi64((__m128i*)(s + i), _mm256_castsi256_si128(b));
+    }
+  from_unicode_8bit_plain(index, pages, us + i, len - i, s + i);
+}
+#endif
+
+static void (*to_unicode_8bit_impl)(const FriBidiChar *table, guchar *s,
+				    gint len, FriBidiChar *us) = NULL;
+static void (*from_unicode_8bit_impl)(const gint32 *index, const guint8 *pages,
+				      FriBidiChar *us, gint len,
+				      guchar *s) = NULL;
+
+static void
+select_8bit_kernels(void)
+{
+#ifdef FRIBIDI_X86_SIMD
+  if (fribidi_cpu_has_avx2())
+    {
+      KERNEL_STORE(to_unicode_8bit_impl, to_unicode_8bit_avx2);
+      KERNEL_STORE(from_unicode_8bit_impl, from_unicode_8bit_avx2);
+      return;
+    }
+#endif
+  KERNEL_STORE(to_unicode_8bit_impl, to_unicode_8bit_plain);
+  KERNEL_STORE(from_unicode_8bit_impl, from_unicode_8bit_plain);
+}
+
+void
+fribidi_8bit_to_unicode(const FriBidiChar *table, guchar *s, gint len,
+			FriBidiChar *us)
+{
+  if (!KERNEL_LOAD(to_unicode_8bit_impl))
+    select_8bit_kernels();
+  KERNEL_LOAD(to_unicode_8bit_impl)(table, s, len, us);
+}
+
+void
+fribidi_unicode_to_8bit(const gint32 *index, const guint8 *pages,
+			FriBidiChar *us, gint len, guchar *s)
+{
+  if (!KERNEL_LOAD(from_unicode_8bit_impl))
+    select_8bit_kernels();
+  KERNEL_LOAD(from_unicode_8bit_impl)(index, pages, us, len, s);
+}
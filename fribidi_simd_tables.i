@@ -0,0 +1,263 @@
+/*======================================================================
+//  This file was automatically created by the perl script
+//  CreateSimdTables.pl. It is included by fribidi_simd.c.
+//----------------------------------------------------------------------*/
+
+static const guint8 utf8_compact_shuffle[256][16] = {
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x0A,0x0C,0x0E,0x0F,0x80,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x0A,0x0C,0x0D,0x0E,0x80,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x09,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x0A,0x0B,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x09,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x07,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x05,0x06,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x03,0x04,0x06,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x03,0x04,0x06,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x01,0x02,0x04,0x06,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80,0x80 },
+  { 0x00,0x02,0x04,0x06,0x08,0x0A,0x0C,0x0E,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80 }
+};
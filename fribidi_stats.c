@@ -0,0 +1,101 @@
+/* FriBidi - Library of BiDi algorithm
+ * Copyright (C) 1999 Dov Grobgeld
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*======================================================================
+//  The statistics of the engine. They are gathered by the macros of
+//  fribidi_private.h when the library is built with
+//  FRIBIDI_ENABLE_STATS, and read as zeros otherwise.
+//----------------------------------------------------------------------*/
+
+#include <string.h>
+#include <time.h>
+#include <glib.h>
+#include "fribidi_private.h"
+
+static const gchar *phase_names[FRIBIDI_NUM_PHASES] = {
+  "classify",
+  "explicit",
+  "weak",
+  "neutral",
+  "levels",
+  "mirror",
+  "reorder"
+};
+
+/* The clock of the machines without a time stamp counter, in
+   nanoseconds */
+guint64
+fribidi_cycles(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (guint64) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+const gchar *
+fribidi_phase_name(FriBidiPhase phase)
+{
+  if (phase < 0 || phase >= FRIBIDI_NUM_PHASES)
+    return NULL;
+  return phase_names[phase];
+}
+
+gboolean
+fribidi_stats_enabled(void)
+{
+#ifdef FRIBIDI_ENABLE_STATS
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
+void
+fribidi_context_get_stats(FriBidiContext *ctx,
+			  /* output */
+			  FriBidiStats *stats)
+{
+#ifdef FRIBIDI_ENABLE_STATS
+  *stats = ctx->engine_stats;
+#else
+  memset(stats, 0, sizeof(FriBidiStats));
+#endif
+}
+
+void
+fribidi_context_reset_stats(FriBidiContext *ctx)
+{
+#ifdef FRIBIDI_ENABLE_STATS
+  memset(&ctx->engine_stats, 0, sizeof(FriBidiStats));
+#endif
+}
+
+void
+fribidi_get_stats(/* output */
+		  FriBidiStats *stats)
+{
+  fribidi_context_get_stats(fribidi_default_context(), stats);
+}
+
+void
+fribidi_reset_stats(void)
+{
+  fribidi_context_reset_stats(fribidi_default_context());
+}
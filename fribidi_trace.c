@@ -0,0 +1,291 @@
+/* FriBidi - Library of BiDi algorithm
+ * Copyright (C) 1999 Dov Grobgeld
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*======================================================================
+//  The trace rings. Every thread that turns tracing on gets a ring of
+//  its own, which only it writes to, so recording takes no lock: the
+//  thread stores an event and then publishes the new head, and the
+//  reader takes events up to the head and then publishes the new
+//  tail. The rings are kept on a list that only grows, so a reader
+//  can walk it while threads add to it. A ring lives as long as the
+//  process.
+//
+//  Tracing needs the __thread storage and the __atomic builtins of
+//  gcc.
+//----------------------------------------------------------------------*/
+
+#include <string.h>
+#include <glib.h>
+#include "fribidi_private.h"
+
+#ifdef FRIBIDI_ENABLE_TRACE
+
+#define RING_MASK (FRIBIDI_TRACE_RING_SIZE - 1)
+
+typedef struct _TraceRing TraceRing;
+
+struct _TraceRing {
+  TraceRing *next;              /* In the list of all the rings */
+  guint8 thread;
+  guint32 head;                 /* Written by the thread */
+  guint32 tail;                 /* Written by the reader */
+  guint32 dropped;              /* Not yet recorded as an event */
+  FriBidiTraceEvent events[FRIBIDI_TRACE_RING_SIZE];
+};
+
+__thread gboolean fribidi_tracing = FALSE;
+static __thread TraceRing *thread_ring = NULL;
+
+static TraceRing *all_rings = NULL;
+static guint32 num_rings = 0;
+
+static TraceRing *
+ring_new(void)
+{
+  TraceRing *ring = g_new0(TraceRing, 1);
+
+  ring->thread = __atomic_fetch_add(&num_rings, 1, __ATOMIC_RELAXED);
+  ring->next = __atomic_load_n(&all_rings, __ATOMIC_RELAXED);
+  while (!__atomic_compare_exchange_n(&all_rings, &ring->next, ring, TRUE,
+				      __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+    ;
+  return ring;
+}
+
+/* Store an event if there is room for it */
+static gboolean
+ring_put(TraceRing *ring,
+	 gint kind,
+	 gint arg,
+	 gint32 v0,
+	 gint32 v1,
+	 gint32 v2)
+{
+  guint32 tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+  FriBidiTraceEvent *event;
+
+  if (ring->head - tail >= FRIBIDI_TRACE_RING_SIZE)
+    return FALSE;
+
+  event = &ring->events[ring->head & RING_MASK];
+  event->kind = kind;
+  event->thread = ring->thread;
+  event->arg = arg;
+  event->values[0] = v0;
+  event->values[1] = v1;
+  event->values[2] = v2;
+  __atomic_store_n(&ring->head, ring->head + 1, __ATOMIC_RELEASE);
+  return TRUE;
+}
+
+void
+fribidi_trace_record(gint kind,
+		     gint arg,
+		     gint32 v0,
+		     gint32 v1,
+		     gint32 v2)
+{
+  TraceRing *ring = thread_ring;
+
+  if (ring->dropped)
+    {
+      if (!ring_put(ring, FRIBIDI_TRACE_DROPPED, 0, ring->dropped, 0, 0))
+	{
+	  ring->dropped++;
+	  return;
+	}
+      ring->dropped = 0;
+    }
+  if (!ring_put(ring, kind, arg, v0, v1, v2))
+    ring->dropped++;
+}
+
+gboolean
+fribidi_trace_enable(gboolean enable)
+{
+  if (enable && !thread_ring)
+    thread_ring = ring_new();
+  fribidi_tracing = enable;
+  return TRUE;
+}
+
+gint
+fribidi_trace_read(/* output */
+		   FriBidiTraceEvent *events,
+		   gint max_events)
+{
+  TraceRing *ring = __atomic_load_n(&all_rings, __ATOMIC_ACQUIRE);
+  gint n = 0;
+
+  for (; ring && n < max_events; ring = ring->next)
+    {
+      guint32 head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+      guint32 tail = ring->tail;
+
+      while (tail != head && n < max_events)
+	events[n++] = ring->events[tail++ & RING_MASK];
+      __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+    }
+  return n;
+}
+
+#else
+
+gboolean
+fribidi_trace_enable(gboolean enable)
+{
+  return FALSE;
+}
+
+gint
+fribidi_trace_read(/* output */
+		   FriBidiTraceEvent *events,
+		   gint max_events)
+{
+  return 0;
+}
+
+#endif /* FRIBIDI_ENABLE_TRACE */
+
+/*======================================================================
+//  Saving and printing the events. fribidi_trace_print() gives the
+//  lines of the old debug output; the runs of a snapshot are printed
+//  together, so a snapshot that is cut by the end of the events is
+//  printed as far as it goes.
+//----------------------------------------------------------------------*/
+#ifndef NO_STDIO
+
+#define SAVE_BLOCK_EVENTS 256
+
+void
+fribidi_trace_write_header(FILE *file)
+{
+  FriBidiTraceHeader header;
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, FRIBIDI_TRACE_MAGIC, 4);
+  header.version = FRIBIDI_TRACE_VERSION;
+  header.byte_order = FRIBIDI_TRACE_BYTE_ORDER;
+  header.event_size = sizeof(FriBidiTraceEvent);
+  fwrite(&header, sizeof(header), 1, file);
+}
+
+gint
+fribidi_trace_save(FILE *file)
+{
+  FriBidiTraceEvent events[SAVE_BLOCK_EVENTS];
+  gint n, total = 0;
+
+  fribidi_trace_write_header(file);
+  while ((n = fribidi_trace_read(events, SAVE_BLOCK_EVENTS)) > 0)
+    {
+      fwrite(events, sizeof(FriBidiTraceEvent), n, file);
+      total += n;
+    }
+  return total;
+}
+
+static const gchar *phase_messages[FRIBIDI_NUM_PHASES] = {
+  "Classifying.",
+  "Resolving explicit levels.",
+  "Resolving weak types.",
+  "Resolving neutral types.",
+  "Resolving implicit levels.",
+  "Mirroring.",
+  "Reordering."
+};
+
+/* Convert a resolved type to something readable */
+static gchar
+resolved_type_char(gint type)
+{
+  if (type == FRIBIDI_TYPE_R)
+    return 'R';
+  else if (type == FRIBIDI_TYPE_L)
+    return 'L';
+  else if (type == FRIBIDI_TYPE_E)
+    return 'E';
+  else if (type == FRIBIDI_TYPE_EN)
+    return 'n';
+  else if (type == FRIBIDI_TYPE_N)
+    return 'N';
+  return '?';
+}
+
+void
+fribidi_trace_print(FILE *file,
+		    const FriBidiTraceEvent *events,
+		    gint num_events)
+{
+  gint i, j, k;
+
+  for (i = 0; i < num_events; i++)
+    {
+      const FriBidiTraceEvent *event = &events[i];
+      gint end;
+
+      switch (event->kind)
+	{
+	case FRIBIDI_TRACE_PARAGRAPH:
+	  for (; i + 1 < num_events && events[i + 1].kind == FRIBIDI_TRACE_CHARS;
+	       i++)
+	    for (j = 0; j < events[i + 1].arg; j++)
+	      fprintf(file, "%c", events[i + 1].values[j]);
+	  fprintf(file, "\n");
+	  break;
+
+	case FRIBIDI_TRACE_PHASE:
+	  if (event->arg >= 0 && event->arg < FRIBIDI_NUM_PHASES)
+	    fprintf(file, "%s\n", phase_messages[event->arg]);
+	  break;
+
+	case FRIBIDI_TRACE_RUNS:
+	  for (end = i + 1;
+	       end < num_events && events[end].kind == FRIBIDI_TRACE_RUN;
+	       end++)
+	    ;
+	  if (event->arg == FRIBIDI_TRACE_TYPES)
+	    {
+	      for (j = i + 1; j < end; j++)
+		fprintf(file, "%d:%c(%d)[%d] ", events[j].values[0],
+			events[j].arg, events[j].values[1], events[j].values[2]);
+	      fprintf(file, "\n");
+	    }
+	  else
+	    {
+	      for (j = i + 1; j < end; j++)
+		for (k = 0; k < events[j].values[1]; k++)
+		  fprintf(file, "%d", events[j].values[2]);
+	      fprintf(file, "\n");
+	      for (j = i + 1; j < end; j++)
+		for (k = 0; k < events[j].values[1]; k++)
+		  fprintf(file, "%c", resolved_type_char(events[j].arg));
+	      fprintf(file, "\n");
+	    }
+	  i = end - 1;
+	  break;
+
+	case FRIBIDI_TRACE_DROPPED:
+	  fprintf(file, "(%d events dropped)\n", events[i].values[0]);
+	  break;
+	}
+    }
+}
+
+#endif /* NO_STDIO */
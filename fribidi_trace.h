@@ -0,0 +1,114 @@
+/* FriBidi - Library of BiDi algorithm
+ * Copyright (C) 1999 Dov Grobgeld
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*======================================================================
+//  The trace of the engine. When the library is built with
+//  FRIBIDI_ENABLE_TRACE, a thread that has turned tracing on with
+//  fribidi_trace_enable() records compact events into a ring buffer of
+//  its own: the text of each paragraph, the start of each phase, and
+//  snapshots of the run length list. Nothing is printed or locked
+//  while the events are recorded. fribidi_trace_read() takes the
+//  events of all the threads out of their rings, and
+//  fribidi_trace_print() prints them in the form of the old debug
+//  output of fribidi_set_debug().
+//
+//  Without FRIBIDI_ENABLE_TRACE the engine has no trace code at all,
+//  fribidi_trace_enable() returns FALSE and nothing is ever read.
+//
+//  A ring that is full drops the newest events, and the number that
+//  was dropped is recorded as an event once there is room again.
+//----------------------------------------------------------------------*/
+#ifndef FRIBIDI_TRACE_H
+#define FRIBIDI_TRACE_H
+
+#include <stdio.h>
+#include "fribidi_types.h"
+
+/* The kinds of the events */
+typedef enum {
+  FRIBIDI_TRACE_PARAGRAPH,      /* values[0] characters, values[1] the
+				   requested base direction */
+  FRIBIDI_TRACE_CHARS,          /* arg characters of the text, in values */
+  FRIBIDI_TRACE_PHASE,          /* arg is the FriBidiPhase that starts */
+  FRIBIDI_TRACE_RUNS,           /* arg is the FriBidiTraceSnapshot that
+				   the next values[0] RUN events make */
+  FRIBIDI_TRACE_RUN,            /* arg is the type, values are the
+				   position, the length and the level */
+  FRIBIDI_TRACE_DROPPED         /* values[0] events were dropped */
+} FriBidiTraceKind;
+
+/* The snapshots of the run length list */
+typedef enum {
+  FRIBIDI_TRACE_TYPES,          /* Types and levels while resolving */
+  FRIBIDI_TRACE_RESOLVED        /* The resolved levels and types */
+} FriBidiTraceSnapshot;
+
+typedef struct {
+  guint8 kind;                  /* FriBidiTraceKind */
+  guint8 thread;                /* The ring of the thread, by creation */
+  gint16 arg;
+  gint32 values[3];
+} FriBidiTraceEvent;
+
+/* A file of events, as written by fribidi_trace_save() and read by
+   fribidi_trace_dump, is a header followed by the events. */
+#define FRIBIDI_TRACE_MAGIC "FBDT"
+#define FRIBIDI_TRACE_VERSION 1
+#define FRIBIDI_TRACE_BYTE_ORDER 0x0102
+
+typedef struct {
+  guint8 magic[4];              /* FRIBIDI_TRACE_MAGIC */
+  guint16 version;              /* FRIBIDI_TRACE_VERSION */
+  guint16 byte_order;           /* FRIBIDI_TRACE_BYTE_ORDER as written */
+  guint32 event_size;           /* sizeof(FriBidiTraceEvent) */
+  guint32 reserved;
+} FriBidiTraceHeader;
+
+/* The events a ring holds; a power of two */
+#ifndef FRIBIDI_TRACE_RING_SIZE
+#define FRIBIDI_TRACE_RING_SIZE 16384
+#endif
+
+/* Turn tracing on or off for the calling thread. Returns FALSE if the
+   library is built without FRIBIDI_ENABLE_TRACE. */
+gboolean fribidi_trace_enable(gboolean enable);
+
+/* Take up to max_events events out of the rings of all the threads,
+   oldest first within each thread, and return their number. One
+   thread at a time may read. */
+gint     fribidi_trace_read(/* output */
+			    FriBidiTraceEvent *events,
+			    gint max_events);
+
+/* Write the FriBidiTraceHeader that starts a file of events. The
+   events may then be appended as they are read. */
+void     fribidi_trace_write_header(FILE *file);
+
+/* Write all the events that are in the rings to file, after a
+   FriBidiTraceHeader. Returns the number of events written. */
+gint     fribidi_trace_save(FILE *file);
+
+/* Print the events as the old debug output: the text of a paragraph,
+   a line for each phase, the runs as "pos:type(len)[level]", and the
+   resolved levels and types a character at a time. */
+void     fribidi_trace_print(FILE *file,
+			     const FriBidiTraceEvent *events,
+			     gint num_events);
+
+#endif /* FRIBIDI_TRACE_H */
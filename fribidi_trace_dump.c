@@ -0,0 +1,125 @@
+/* FriBidi - Library of BiDi algorithm
+ * Copyright (C) 1999 Dov Grobgeld
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.	 See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*======================================================================
+//  fribidi_trace_dump prints a file of trace events, as written by
+//  fribidi_trace_save(), in the form of the old debug output.
+//----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fribidi.h"
+#include "fribidi_trace.h"
+
+#define CASE(s) if (strcmp(S_, s) == 0)
+
+int main(int argc, char *argv[])
+{
+  int argp=1;
+  int thread = -1;
+  FILE *IN;
+  FriBidiTraceHeader header;
+  FriBidiTraceEvent *events;
+  gint num_events = 0, max_events = 1024;
+  gint i, j;
+
+  while(argp< argc && argv[argp][0] == '-')
+    {
+      gchar *S_ = argv[argp++];
+
+      CASE("-help") {
+	printf(
+	       "fribidi_trace_dump - Print a trace of the fribidi library\n"
+	       "\n"
+	       "Syntax:\n"
+	       "    fribidi_trace_dump [-thread n] file\n"
+	       "\n"
+	       "Description:\n"
+	       "    Prints the events of a file written by fribidi_trace_save(),\n"
+	       "    for instance by test_fribidi -trace, as the debug output of\n"
+	       "    the library.\n"
+	       "\n"
+	       "Options:\n"
+	       "    -thread n     Print only the events of thread n.\n"
+	       );
+	exit(0);
+      }
+
+      CASE("-thread") { thread = atoi(argv[argp++]); continue; };
+      fprintf(stderr, "Unknown option %s!\n", S_);
+      exit(0);
+    }
+
+  if (argp >= argc)
+    {
+      fprintf(stderr, "No file given!\n");
+      exit(1);
+    }
+
+  IN = fopen(argv[argp], "rb");
+  if (!IN)
+    {
+      fprintf(stderr, "Failed opening %s\n", argv[argp]);
+      exit(1);
+    }
+
+  if (fread(&header, sizeof(header), 1, IN) != 1
+      || memcmp(header.magic, FRIBIDI_TRACE_MAGIC, 4) != 0)
+    {
+      fprintf(stderr, "%s is not a trace file!\n", argv[argp]);
+      exit(1);
+    }
+  if (header.version != FRIBIDI_TRACE_VERSION
+      || header.byte_order != FRIBIDI_TRACE_BYTE_ORDER
+      || header.event_size != sizeof(FriBidiTraceEvent))
+    {
+      fprintf(stderr, "%s is of another version or machine!\n", argv[argp]);
+      exit(1);
+    }
+
+  events = g_new(FriBidiTraceEvent, max_events);
+  for (;;)
+    {
+      if (num_events == max_events)
+	{
+	  max_events *= 2;
+	  events = g_renew(FriBidiTraceEvent, events, max_events);
+	}
+      i = fread(events + num_events, sizeof(FriBidiTraceEvent),
+		max_events - num_events, IN);
+      if (i <= 0)
+	break;
+      num_events += i;
+    }
+  fclose(IN);
+
+  /* Keep the events of the thread that is asked for */
+  if (thread >= 0)
+    {
+      for (i = j = 0; i < num_events; i++)
+	if (events[i].thread == thread)
+	  events[j++] = events[i];
+      num_events = j;
+    }
+
+  fribidi_trace_print(stdout, events, num_events);
+
+  g_free(events);
+  return 0;
+}
@@ -65,10 +65,111 @@ typedef struct {
   void *attribute;
 } FriBidiRunType;
 
+/* A run of characters that have the same embedding level, as given
+   by fribidi_log2vis_get_level_runs(). */
+typedef struct {
+  gint start;
+  gint length;
+  guint8 level;
+} FriBidiLevelRun;
+
+/* The following type is used to route the scratch memory of the
+   bidi algorithm to a user supplied allocator. The reset function
+   may be NULL for allocators that can't release memory wholesale. */
+typedef struct _FriBidiAllocator FriBidiAllocator;
+
+struct _FriBidiAllocator {
+  gpointer (*alloc) (gsize size, gpointer user_data);
+  void     (*free)  (gpointer mem, gpointer user_data);
+  void     (*reset) (gpointer user_data);
+  gpointer user_data;
+};
+
+/* An opaque context holding the allocator and the memory pools used
+   by the bidi algorithm. */
+typedef struct _FriBidiContext FriBidiContext;
+
+/* A character set and its converters; the structure is defined in
+   fribidi_char_sets.h. */
+typedef struct _FriBidiCharSet FriBidiCharSet;
+
+/* Memory statistics of a context, in bytes. The peak is the high
+   water mark of the memory in use and pooled together. */
+typedef struct {
+  gsize bytes_in_use;
+  gsize bytes_pooled;
+  gsize peak_bytes;
+} FriBidiMemoryStats;
+
+/* The phases of the algorithm that are timed when the library is
+   built with FRIBIDI_ENABLE_STATS */
+typedef enum {
+  FRIBIDI_PHASE_CLASSIFY,       /* Types of the characters, run lengths */
+  FRIBIDI_PHASE_EXPLICIT,       /* X1 to X10 */
+  FRIBIDI_PHASE_WEAK,           /* W1 to W7 */
+  FRIBIDI_PHASE_NEUTRAL,        /* N1 and N2 */
+  FRIBIDI_PHASE_LEVELS,         /* I1 and I2, and writing the levels */
+  FRIBIDI_PHASE_MIRROR,         /* L4 */
+  FRIBIDI_PHASE_REORDER,        /* L2, and writing the maps */
+  FRIBIDI_NUM_PHASES
+} FriBidiPhase;
+
+/* Statistics of the work of a context, summed over its calls. The
+   phases are timed in cycles of the time stamp counter where there is
+   one, and in nanoseconds elsewhere. */
+typedef struct {
+  guint64 calls;                /* Paragraphs analysed */
+  guint64 chars;                /* Characters analysed */
+  guint64 phase_cycles[FRIBIDI_NUM_PHASES];
+  guint64 runs_created;         /* Links made by the run length encoding */
+  guint64 compact_merges;       /* Links merged into their neighbour */
+  guint64 mirror_lookups;
+  guint64 reversals;
+  guint64 reversed_runs;        /* Summed length of the run reversals */
+  guint64 reversed_chars;       /* Summed length of the string reversals */
+} FriBidiStats;
+
+/* The units of the position maps and the levels of the UTF-8 and
+   UTF-16 interfaces: code units (bytes or 16 bit units), or
+   characters. */
+typedef enum {
+  FRIBIDI_MAP_CODE_UNITS,
+  FRIBIDI_MAP_CHARS
+} FriBidiMapUnits;
+
+/* A piece of a paragraph that is held in several buffers */
+typedef struct {
+  FriBidiChar *str;
+  gint len;
+} FriBidiSegment;
+
+/* An iterator over an analysed paragraph in visual order, set up by
+   fribidi_visual_iter_init(). The fields are private. */
+typedef struct {
+  FriBidiContext *ctx;
+  FriBidiChar *str;
+  gpointer type_rl_list;
+  gpointer runs;
+  guint16 *order;
+  gint num_runs;
+  gint run_idx;                 /* The visual run being read */
+  gint char_idx;                /* Characters read in the run */
+} FriBidiVisualIter;
+
 /* The following should be configuration parameters, once I can
    figure out how to make configure set them... */
 #ifndef FRIBIDI_MAX_STRING_LENGTH
 #define FRIBIDI_MAX_STRING_LENGTH 65535
 #endif
 
+/* The default number of released run-length links that a context
+   keeps for reuse. */
+#ifndef FRIBIDI_POOL_LIMIT
+#define FRIBIDI_POOL_LIMIT 4096
+#endif
+
+#ifndef FRIBIDI_ARENA_DEFAULT_BLOCK_SIZE
+#define FRIBIDI_ARENA_DEFAULT_BLOCK_SIZE 65536
+#endif
+
 #endif
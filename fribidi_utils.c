@@ -24,7 +24,7 @@
 //  writers.
 //----------------------------------------------------------------------*/
 
-#include "fribidi.h"
+#include "fribidi_private.h"
 
 /*======================================================================
 //  The find_visual_ranges() function is used to convert between a
@@ -324,6 +324,190 @@ fribidi_is_char_rtl(guint8 *embedding_level_list,
       return embedding_level_list[idx] % 2;
 }
 
+/*======================================================================
+//  Positions in a paragraph held in segments. Empty segments are
+//  skipped, so a position is always located in a segment that holds
+//  a character.
+//----------------------------------------------------------------------*/
+gboolean
+fribidi_segments_locate(FriBidiSegment *segments,
+			gint num_segments,
+			gint idx,
+			/* output */
+			gint *segment,
+			gint *offset)
+{
+  gint seg;
+
+  if (idx < 0)
+    return FALSE;
+
+  for (seg=0; seg<num_segments; seg++)
+    {
+      if (idx < segments[seg].len)
+	{
+	  *segment = seg;
+	  *offset = idx;
+	  return TRUE;
+	}
+      idx -= segments[seg].len;
+    }
+  return FALSE;
+}
+
+gint
+fribidi_segments_index(FriBidiSegment *segments,
+		       gint segment,
+		       gint offset)
+{
+  gint seg;
+
+  for (seg=0; seg<segment; seg++)
+    offset += segments[seg].len;
+  return offset;
+}
+
+/*======================================================================
+//  Lookups in run length encoded levels. The runs are in logical
+//  order and don't overlap, so the run holding a character is found
+//  by bisection on the starts of the runs.
+//----------------------------------------------------------------------*/
+gint
+fribidi_level_runs_find(FriBidiLevelRun *level_runs,
+			gint num_runs,
+			gint idx)
+{
+  gint lo = 0, hi = num_runs;
+
+  /* Find the last run that starts at or before idx */
+  while (hi - lo > 1)
+    {
+      gint mid = (lo + hi) / 2;
+      if (level_runs[mid].start <= idx)
+	lo = mid;
+      else
+	hi = mid;
+    }
+
+  if (num_runs == 0
+      || idx < level_runs[lo].start
+      || idx >= level_runs[lo].start + level_runs[lo].length)
+    return -1;
+  return lo;
+}
+
+gint
+fribidi_level_runs_level_at(FriBidiLevelRun *level_runs,
+			    gint num_runs,
+			    gint idx)
+{
+  gint run = fribidi_level_runs_find(level_runs, num_runs, idx);
+
+  return run < 0 ? -1 : level_runs[run].level;
+}
+
+gboolean
+fribidi_level_runs_is_rtl_at(FriBidiLevelRun *level_runs,
+			     gint num_runs,
+			     gint idx)
+{
+  return fribidi_level_runs_level_at(level_runs, num_runs, idx) % 2 == 1;
+}
+
+/*======================================================================
+//  Queries on the rtl mask. The bits of a character range are taken a
+//  word at a time, with the partial words at the ends masked.
+//----------------------------------------------------------------------*/
+static gint
+popcount64(guint64 x)
+{
+#ifdef __GNUC__
+  return __builtin_popcountll(x);
+#else
+  gint n = 0;
+  for (; x; x &= x - 1)
+    n++;
+  return n;
+#endif
+}
+
+static gint
+lowest_bit64(guint64 x)
+{
+#ifdef __GNUC__
+  return __builtin_ctzll(x);
+#else
+  gint n = 0;
+  for (; !(x & 1); x >>= 1)
+    n++;
+  return n;
+#endif
+}
+
+/* The bits from bit up to the end of the word */
+#define BITS_FROM(bit) (~(guint64)0 << (bit))
+
+gint
+fribidi_rtl_mask_count(guint64 *rtl_mask,
+		       gint start,
+		       gint end)
+{
+  gint first = start / 64, last = end / 64;
+  gint count = 0;
+  gint i;
+
+  if (start >= end)
+    return 0;
+
+  if (first == last)
+    return popcount64(rtl_mask[first]
+		      & BITS_FROM(start % 64) & ~BITS_FROM(end % 64));
+
+  count = popcount64(rtl_mask[first] & BITS_FROM(start % 64));
+  for (i=first+1; i<last; i++)
+    count += popcount64(rtl_mask[i]);
+  if (end % 64)
+    count += popcount64(rtl_mask[last] & ~BITS_FROM(end % 64));
+
+  return count;
+}
+
+gint
+fribidi_rtl_mask_next_change(guint64 *rtl_mask,
+			     gint len,
+			     gint idx)
+{
+  gint word = idx / 64;
+  gint num_words = (len + 63) / 64;
+  guint64 flip;
+  guint64 bits;
+
+  if (idx + 1 >= len)
+    return len;
+
+  /* Flip the bits so that a change of direction is a set bit */
+  flip = (rtl_mask[word] >> (idx % 64)) & 1 ? ~(guint64)0 : 0;
+  bits = (rtl_mask[word] ^ flip) & BITS_FROM(idx % 64) << 1;
+
+  while (!bits)
+    {
+      if (++word >= num_words)
+	return len;
+      bits = rtl_mask[word] ^ flip;
+    }
+
+  return MIN(word * 64 + lowest_bit64(bits), len);
+}
+
+void
+fribidi_rtl_mask_expand(guint64 *rtl_mask,
+			gint len,
+			/* output */
+			guint8 *levels)
+{
+  fribidi_expand_bits_u8(rtl_mask, len, levels);
+}
+
 /*======================================================================
 //  fribidi_runs_log2vis takes a list of logical runs and returns a
 //  a list of visual runs. A run is defined as a sequence that has
@@ -17,10 +17,47 @@
  * Boston, MA 02111-1307, USA.
  */
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "fribidi.h"
+#include "fribidi_binary.h"
+#include "fribidi_trace.h"
 
 #define CASE(s) if (strcmp(S_, s) == 0)
 
+/* Printable stand-ins for the explicit codes, and the iso-8859-8
+   codes they are mapped to by -explicit */
+static const gchar explicit_chars[] = "{}[]|";
+static const guchar explicit_codes[] = { 251, 252, 219, 220, 221 };
+
+/* Take the events the library has traced so far, print them for
+   -debug, and add them to the file of -trace. All are taken at once,
+   so that no snapshot of the runs is cut in two. */
+static void drain_trace(gboolean do_debug, FILE *trace_file)
+{
+  static FriBidiTraceEvent *events = NULL;
+  static gint max_events = 0;
+  gint num_events = 0, n;
+
+  for (;;)
+    {
+      if (num_events == max_events)
+	{
+	  max_events = max_events ? 2 * max_events : 1024;
+	  events = g_renew(FriBidiTraceEvent, events, max_events);
+	}
+      n = fribidi_trace_read(events + num_events, max_events - num_events);
+      if (n <= 0)
+	break;
+      num_events += n;
+    }
+
+  if (do_debug)
+    fribidi_trace_print(stdout, events, num_events);
+  if (trace_file)
+    fwrite(events, sizeof(FriBidiTraceEvent), num_events, trace_file);
+}
+
 int main(int argc, char *argv[])
 {
   int argp=1;
@@ -37,6 +74,22 @@ int main(int argc, char *argv[])
   gboolean do_no_pad = FALSE;
   gboolean do_print_embedding = FALSE;
   gboolean do_test_changes = FALSE;
+  gboolean do_in_place = FALSE;
+  gboolean do_explicit = FALSE;
+  gboolean do_print_level_runs = FALSE;
+  gboolean do_print_rtl_mask = FALSE;
+  gboolean do_visual_iter = FALSE;
+  gboolean do_segments = FALSE;
+  gboolean do_utf8 = FALSE;
+  gboolean do_utf16 = FALSE;
+  gboolean do_charset_native = FALSE;
+  gboolean do_charset_encoded = FALSE;
+  gboolean do_reorder_line = FALSE;
+  gboolean do_debug = FALSE;
+  FILE *trace_file = NULL;
+  guchar *binary = NULL;
+  const FriBidiBinaryLine *record = NULL, *line_record;
+  glong binary_size = 0;
 
   while(argp< argc && argv[argp][0] == '-')
     {
@@ -48,7 +101,11 @@ int main(int argc, char *argv[])
 	       "\n"
 	       "Syntax:\n"
 	       "    test_fribidi [-debug] [-outputonly] [-test_vtol] [-order] [-capital_rtl]\n"
-	       "                 [-nopad]\n"
+	       "                 [-nopad] [-explicit] [-print_level_runs]\n"
+	       "                 [-print_rtl_mask] [-visual_iter] [-segments]\n"
+	       "                 [-utf8] [-utf16] [-charset_native] [-charset_encoded]\n"
+	       "                 [-reorder_line] [-check_binary file]\n"
+	       "                 [-trace file]\n"
 	       "\n"
 	       "Description:\n"
 	       "    A program for running the BiDi algorithm on all the lines in\n"
@@ -56,11 +113,28 @@ int main(int argc, char *argv[])
 	       "\n"
 	       "Options:\n"
 	       "    -debug      Output debug info about the progress of the algorithm\n"
+	       "                The library must be built with FRIBIDI_ENABLE_TRACE.\n"
 	       "    -outputonly Don't print the original logical strings.\n"
 	       "    -test_vtol  Output string is according to the ltov array.\n"
 	       "    -test_ltov  Output string is according to the vtol array.\n"
 	       "    -capital_rtl  Treat capital letters as RTL letters.\n"
 	       "    -test_changes  Output information about changes.\n"
+	       "    -in_place   Reorder the logical string in place.\n"
+	       "    -explicit   Treat {}[]| as LRE, RLE, LRO, RLO and PDF.\n"
+	       "    -print_level_runs  Print the levels as start:length:level runs.\n"
+	       "    -print_rtl_mask  Print the rtl count and direction changes.\n"
+	       "    -visual_iter  Take the visual string from the visual iterator.\n"
+	       "    -segments   Check the analysis of the string cut into segments.\n"
+	       "    -utf8       Check the UTF-8 interface against the UCS-4 one.\n"
+	       "    -utf16      Check the UTF-16 interface against the UCS-4 one.\n"
+	       "    -charset_native  Check the 8-bit interface against the UCS-4 one.\n"
+	       "    -charset_encoded  Check the encoded visual strings against the\n"
+	       "                UCS-4 one.\n"
+	       "    -reorder_line  Check the reordering from the embedding levels.\n"
+	       "    -check_binary  Check the output of fribidi -binary for the test\n"
+	       "                file, which is read from file.\n"
+	       "    -trace      Write the trace of the library to file, for\n"
+	       "                fribidi_trace_dump.\n"
 	       );
 	exit(0);
       }
@@ -68,15 +142,63 @@ int main(int argc, char *argv[])
       CASE("-outputonly")  { do_output_only++; pad_width = 80; continue; };
       CASE("-test_vtol") { do_test_vtol++; continue; };
       CASE("-print_embedding") { do_print_embedding++; continue; };
-      CASE("-debug") { fribidi_set_debug(TRUE); continue; };
+      CASE("-debug") { do_debug++; continue; };
       CASE("-order") { do_use_order++; continue; };
       CASE("-capital_rtl") { do_cap_as_rtl++; continue; }; 
       CASE("-nopad") { do_no_pad++; continue; };
       CASE("-test_changes") { do_test_changes++; continue; };
+      CASE("-in_place") { do_in_place++; continue; };
+      CASE("-explicit") { do_explicit++; continue; };
+      CASE("-print_level_runs") { do_print_level_runs++; continue; };
+      CASE("-print_rtl_mask") { do_print_rtl_mask++; continue; };
+      CASE("-visual_iter") { do_visual_iter++; continue; };
+      CASE("-segments") { do_segments++; continue; };
+      CASE("-utf8") { do_utf8++; continue; };
+      CASE("-utf16") { do_utf16++; continue; };
+      CASE("-charset_native") { do_charset_native++; continue; };
+      CASE("-charset_encoded") { do_charset_encoded++; continue; };
+      CASE("-reorder_line") { do_reorder_line++; continue; };
+      CASE("-check_binary")
+	{
+	  FILE *binary_file = fopen(argv[argp++], "rb");
+
+	  if (!binary_file)
+	    {
+	      fprintf(stderr, "Can't open %s!\n", argv[argp-1]);
+	      exit(1);
+	    }
+	  fseek(binary_file, 0, SEEK_END);
+	  binary_size = ftell(binary_file);
+	  rewind(binary_file);
+	  binary = g_malloc(binary_size);
+	  if (fread(binary, 1, binary_size, binary_file) != binary_size
+	      || binary_size < sizeof(FriBidiBinaryHeader)
+	      || memcmp(binary, FRIBIDI_BINARY_MAGIC, 4) != 0)
+	    printf("Bad binary header\n");
+	  else
+	    record = FRIBIDI_BINARY_FIRST_LINE(binary);
+	  fclose(binary_file);
+	  continue;
+	};
+
+      CASE("-trace")
+	{
+	  trace_file = fopen(argv[argp++], "wb");
+	  if (!trace_file)
+	    {
+	      fprintf(stderr, "Can't open %s!\n", argv[argp-1]);
+	      exit(1);
+	    }
+	  fribidi_trace_write_header(trace_file);
+	  continue;
+	};
 
       fprintf(stderr, "Unknown option %s!\n", S_);
       exit(0);
     }
+
+  if ((do_debug || trace_file) && !fribidi_trace_enable(TRUE))
+    fprintf(stderr, "The library is built without FRIBIDI_ENABLE_TRACE!\n");
   
   if (argp >= argc) {
     IN = stdin;
@@ -94,6 +216,14 @@ int main(int argc, char *argv[])
       FriBidiCharType base;
       int i;
 
+      /* fribidi writes a record for every line */
+      line_record = NULL;
+      if (record && (guchar *) record < binary + binary_size)
+	{
+	  line_record = record;
+	  record = FRIBIDI_BINARY_NEXT_LINE(record);
+	}
+
       len = strlen(S_);
       
       if (S_[0] == '#')
@@ -117,17 +247,262 @@ int main(int argc, char *argv[])
 	  if (S_[i]>='A' && S_[i]<='Z')
 	    S_[i]+= 0xE0 - 'A';  /* Map to iso Hebrew */
 
+      if (do_explicit)
+	for (i=0; i<len; i++)
+	  {
+	    gchar *p = strchr(explicit_chars, S_[i]);
+	    if (S_[i] && p)
+	      S_[i] = explicit_codes[p - explicit_chars];
+	  }
+
       fribidi_iso8859_8_to_unicode(S_, us);
 
       /* Create a bidi string */
       base = FRIBIDI_TYPE_N;
-      fribidi_log2vis(us, len, &base, 
-		      /* output */
-		      out_us,
-		      positionLtoV,
-		      positionVtoL,
-		      embedding_list
-		      );
+      if (do_in_place)
+	{
+	  memcpy(out_us, us, (len+1) * sizeof(FriBidiChar));
+	  fribidi_log2vis_in_place(out_us, len, &base,
+				   /* output */
+				   positionLtoV,
+				   positionVtoL,
+				   embedding_list
+				   );
+	}
+      else
+	fribidi_log2vis(us, len, &base, 
+			/* output */
+			out_us,
+			positionLtoV,
+			positionVtoL,
+			embedding_list
+			);
+
+      /* The trace of the line comes where the debug output used to */
+      drain_trace(do_debug, trace_file);
+
+      if (do_visual_iter)
+	{
+	  FriBidiVisualIter iter;
+	  FriBidiLevelRun run;
+	  FriBidiChar ch;
+	  gint log_pos, vis_pos;
+
+	  /* The characters must come in the order of the V to L map */
+	  base = FRIBIDI_TYPE_N;
+	  fribidi_visual_iter_init(&iter, us, len, &base);
+	  for (vis_pos = 0;
+	       fribidi_visual_iter_next_char(&iter, &ch, &log_pos);
+	       vis_pos++)
+	    {
+	      if (log_pos != positionVtoL[vis_pos])
+		printf("Position mismatch at %d\n", vis_pos);
+	      out_us[vis_pos] = ch;
+	    }
+	  fribidi_visual_iter_free(&iter);
+
+	  /* And so must the runs */
+	  base = FRIBIDI_TYPE_N;
+	  fribidi_visual_iter_init(&iter, us, len, &base);
+	  for (vis_pos = 0; fribidi_visual_iter_next_run(&iter, &run); )
+	    for (i=0; i<run.length; i++, vis_pos++)
+	      {
+		log_pos = run.level % 2 ? run.start + run.length - 1 - i
+		                        : run.start + i;
+		if (log_pos != positionVtoL[vis_pos])
+		  printf("Run mismatch at %d\n", vis_pos);
+	      }
+	  fribidi_visual_iter_free(&iter);
+	}
+
+      if (do_segments)
+	{
+	  FriBidiSegment segments[255];
+	  guint16 seg_LtoV[255], seg_VtoL[255];
+	  guint8 seg_embedding[255];
+	  gint num_segments = 0;
+	  gint pos = 0;
+
+	  /* Cut the string into segments of growing length, with an
+	     empty one between them */
+	  for (i=1; pos<len; i++)
+	    {
+	      segments[num_segments].str = us + pos;
+	      segments[num_segments].len = (i % 2) ? MIN(i, len-pos) : 0;
+	      pos += segments[num_segments++].len;
+	    }
+
+	  base = FRIBIDI_TYPE_N;
+	  fribidi_log2vis_segments(segments, num_segments, &base,
+				   seg_LtoV, seg_VtoL, seg_embedding);
+	  for (i=0; i<len; i++)
+	    {
+	      gint seg, offset;
+
+	      if (seg_LtoV[i] != positionLtoV[i]
+		  || seg_VtoL[i] != positionVtoL[i]
+		  || seg_embedding[i] != embedding_list[i])
+		printf("Segment mismatch at %d\n", i);
+	      if (!fribidi_segments_locate(segments, num_segments, i,
+					   &seg, &offset)
+		  || segments[seg].str + offset != us + i
+		  || fribidi_segments_index(segments, seg, offset) != i)
+		printf("Segment position mismatch at %d\n", i);
+	    }
+	}
+
+      if (do_utf8)
+	{
+	  guchar utf8[255 * 3 + 1], vis_utf8[255 * 3 + 1], out_utf8[255 * 3 + 1];
+	  gint LtoV[255 * 3], VtoL[255 * 3];
+	  guint8 levels[255 * 3];
+	  gint utf8_len, n;
+
+	  fribidi_unicode_to_utf8(us, len, utf8);
+	  fribidi_unicode_to_utf8(out_us, len, out_utf8);
+	  utf8_len = strlen((gchar *) utf8);
+
+	  /* In characters the maps are those of fribidi_log2vis() */
+	  base = FRIBIDI_TYPE_N;
+	  n = fribidi_log2vis_utf8(utf8, utf8_len, &base, FRIBIDI_MAP_CHARS,
+				   vis_utf8, LtoV, VtoL, levels);
+	  if (n != len || memcmp(vis_utf8, out_utf8, utf8_len) != 0)
+	    printf("UTF-8 visual string mismatch\n");
+	  for (i=0; i<len; i++)
+	    if (LtoV[i] != positionLtoV[i] || VtoL[i] != positionVtoL[i]
+		|| levels[i] != embedding_list[i])
+	      printf("UTF-8 character map mismatch at %d\n", i);
+
+	  /* In bytes the maps must carry every byte to its place */
+	  base = FRIBIDI_TYPE_N;
+	  n = fribidi_log2vis_utf8(utf8, utf8_len, &base,
+				   FRIBIDI_MAP_CODE_UNITS,
+				   NULL, LtoV, VtoL, NULL);
+	  for (i=0; i<n; i++)
+	    if (VtoL[LtoV[i]] != i
+		|| ((utf8[i] & 0xC0) == 0x80) != ((out_utf8[LtoV[i]] & 0xC0) == 0x80))
+	      printf("UTF-8 byte map mismatch at %d\n", i);
+	}
+
+      if (do_utf16)
+	{
+	  guint16 utf16[255], vis_utf16[255];
+	  gint LtoV[255], VtoL[255];
+	  guint8 levels[255];
+	  gint n;
+
+	  /* The test strings are all in the basic multilingual plane */
+	  for (i=0; i<len; i++)
+	    utf16[i] = us[i];
+
+	  base = FRIBIDI_TYPE_N;
+	  n = fribidi_log2vis_utf16(utf16, len, &base, FRIBIDI_MAP_CODE_UNITS,
+				    vis_utf16, LtoV, VtoL, NULL);
+	  if (n != len)
+	    printf("UTF-16 length mismatch\n");
+	  for (i=0; i<len; i++)
+	    if (vis_utf16[i] != out_us[i]
+		|| LtoV[i] != positionLtoV[i] || VtoL[i] != positionVtoL[i])
+	      printf("UTF-16 mismatch at %d\n", i);
+
+	  base = FRIBIDI_TYPE_N;
+	  fribidi_log2vis_utf16_get_embedding_levels(utf16, len, &base,
+						     FRIBIDI_MAP_CHARS,
+						     levels);
+	  for (i=0; i<len; i++)
+	    if (levels[i] != embedding_list[i])
+	      printf("UTF-16 level mismatch at %d\n", i);
+	}
+
+      if (do_charset_native)
+	{
+	  guchar vis_8bit[255], out_8bit[255];
+	  guint16 LtoV[255], VtoL[255];
+	  guint8 levels[255];
+
+	  /* The input is in ISO 8859-8, and is reordered as it is */
+	  base = FRIBIDI_TYPE_N;
+	  fribidi_log2vis_charset(FRIBIDI_CHARSET_8859_8, S_, len, &base,
+				  vis_8bit, LtoV, VtoL, levels);
+	  fribidi_unicode_to_iso8859_8(out_us, len, out_8bit);
+	  for (i=0; i<len; i++)
+	    if (vis_8bit[i] != out_8bit[i]
+		|| LtoV[i] != positionLtoV[i] || VtoL[i] != positionVtoL[i]
+		|| levels[i] != embedding_list[i])
+	      printf("8-bit mismatch at %d\n", i);
+	}
+
+      if (do_charset_encoded)
+	{
+	  guchar vis_bytes[255 * 4], out_bytes[255 * 4];
+	  guint16 LtoV[255], VtoL[255];
+	  guint8 levels[255];
+	  gint cs, n, out_len, consumed, vis_consumed;
+
+	  for (cs=0; fribidi_char_set_nth(cs); cs++)
+	    {
+	      const FriBidiCharSet *char_set = fribidi_char_set_nth(cs);
+
+	      out_len = char_set->encode(char_set, out_us, len, out_bytes,
+					 sizeof(out_bytes), &consumed);
+
+	      base = FRIBIDI_TYPE_N;
+	      n = fribidi_log2vis_to_charset(us, len, &base, char_set,
+					     vis_bytes, sizeof(vis_bytes),
+					     &vis_consumed, LtoV, VtoL, levels);
+	      if (n != out_len || vis_consumed != consumed
+		  || memcmp(vis_bytes, out_bytes, n) != 0)
+		printf("%s visual bytes mismatch\n", char_set->name);
+	      for (i=0; i<len; i++)
+		if (LtoV[i] != positionLtoV[i] || VtoL[i] != positionVtoL[i]
+		    || levels[i] != embedding_list[i])
+		  printf("%s map mismatch at %d\n", char_set->name, i);
+
+	      /* A short buffer must end with the last character that
+		 fits, as the encoder of the set ends it */
+	      if (out_len > 1)
+		{
+		  gint size = out_len - 1;
+
+		  out_len = char_set->encode(char_set, out_us, len, out_bytes,
+					     size, &consumed);
+		  base = FRIBIDI_TYPE_N;
+		  n = fribidi_log2vis_to_charset(us, len, &base, char_set,
+						 vis_bytes, size, &vis_consumed,
+						 NULL, NULL, NULL);
+		  if (n != out_len || vis_consumed != consumed
+		      || vis_consumed >= len
+		      || memcmp(vis_bytes, out_bytes, n) != 0)
+		    printf("%s short buffer mismatch\n", char_set->name);
+		}
+	    }
+	}
+
+      if (do_reorder_line)
+	{
+	  FriBidiChar vis_us[255];
+	  guint16 LtoV[255], VtoL[255];
+	  gint half = len / 2;
+
+	  /* The whole string as one line is the string of log2vis */
+	  fribidi_reorder_line(us, len, embedding_list, vis_us, LtoV, VtoL);
+	  for (i=0; i<len; i++)
+	    if (vis_us[i] != out_us[i]
+		|| LtoV[i] != positionLtoV[i] || VtoL[i] != positionVtoL[i])
+	      printf("Line mismatch at %d\n", i);
+
+	  /* Each of two lines must be reordered within itself */
+	  fribidi_reorder_line(us, half, embedding_list, vis_us, LtoV, VtoL);
+	  fribidi_reorder_line(us + half, len - half, embedding_list + half,
+			       vis_us + half, LtoV + half, VtoL + half);
+	  for (i=0; i<len; i++)
+	    {
+	      gint base_pos = i < half ? 0 : half;
+
+	      if (VtoL[LtoV[i] + base_pos] != i - base_pos)
+		printf("Broken line map mismatch at %d\n", i);
+	    }
+	}
 
       if (do_test_changes)
 	{
@@ -150,7 +525,42 @@ int main(int argc, char *argv[])
 	for (i=0; i<len; i++)
 	  if (outstring[i]>=0xE0 && outstring[i]<=0xFA)
 	    outstring[i]-= 0xE0 - 'A';  /* Map to capital letters */
+
+      if (do_explicit)
+	for (i=0; i<len; i++)
+	  {
+	    gint j;
+	    for (j=0; j<sizeof(explicit_codes); j++)
+	      if (outstring[i] == explicit_codes[j])
+		outstring[i] = explicit_chars[j];
+	  }
       
+      if (binary)
+	{
+	  const FriBidiBinaryLevelRun *runs;
+	  gint run, pos = 0;
+
+	  if (!line_record || line_record->len != len
+	      || line_record->text_bytes != len
+	      || line_record->base_level != (base == FRIBIDI_TYPE_R))
+	    printf("Binary record mismatch\n");
+	  else
+	    {
+	      runs = FRIBIDI_BINARY_LEVEL_RUNS(line_record);
+	      for (run=0; run<line_record->num_level_runs; run++)
+		for (i=0; i<runs[run].length; i++, pos++)
+		  if (pos >= len || runs[run].level != embedding_list[pos])
+		    printf("Binary level mismatch at %d\n", pos);
+	      if (pos != len)
+		printf("Binary level runs mismatch\n");
+	      for (i=0; i<len; i++)
+		if (FRIBIDI_BINARY_L_TO_V(line_record)[i] != positionLtoV[i]
+		    || FRIBIDI_BINARY_V_TO_L(line_record)[i] != positionVtoL[i]
+		    || FRIBIDI_BINARY_TEXT(line_record)[i] != outstring[i])
+		  printf("Binary mismatch at %d\n", i);
+	    }
+	}
+
       if (base == FRIBIDI_TYPE_R && !do_no_pad)
 	for (i=0; i<pad_width-len; i++)
 	  printf(" ");
@@ -185,7 +595,85 @@ int main(int argc, char *argv[])
 	    printf("%d", embedding_list[i]);
 	  printf("\n");
 	}
+      if (do_print_level_runs)
+	{
+	  FriBidiLevelRun level_runs[255], vis_level_runs[255];
+	  FriBidiChar vis_us[256];
+	  guint16 LtoV[255];
+	  gint num_runs;
+
+	  base = FRIBIDI_TYPE_N;
+	  num_runs = fribidi_log2vis_get_level_runs(us, len, &base,
+						    level_runs, 255);
+	  for (i=0; i<num_runs; i++)
+	    printf("%d:%d:%d ", level_runs[i].start, level_runs[i].length,
+		   level_runs[i].level);
+	  printf("\n");
+
+	  /* The runs that come with the visual string must be the same */
+	  base = FRIBIDI_TYPE_N;
+	  if (fribidi_log2vis_level_runs(us, len, &base, vis_us, LtoV, NULL,
+					 NULL, vis_level_runs, 255) != num_runs)
+	    printf("Level run count mismatch\n");
+	  for (i=0; i<num_runs; i++)
+	    if (vis_level_runs[i].start != level_runs[i].start
+		|| vis_level_runs[i].length != level_runs[i].length
+		|| vis_level_runs[i].level != level_runs[i].level)
+	      printf("Level run mismatch at %d\n", i);
+	  for (i=0; i<len; i++)
+	    if (vis_us[i] != out_us[i] || LtoV[i] != positionLtoV[i])
+	      printf("Level runs visual mismatch at %d\n", i);
+
+	  /* The lookups must agree with the embedding levels */
+	  for (i=-1; i<=len; i++)
+	    {
+	      gint level = (i < 0 || i == len) ? -1 : embedding_list[i];
+	      if (fribidi_level_runs_level_at(level_runs, num_runs, i) != level)
+		printf("Level mismatch at %d\n", i);
+	    }
+	}
+      if (do_print_rtl_mask)
+	{
+	  guint64 rtl_mask[4], vis_rtl_mask[4];
+	  FriBidiChar vis_us[256];
+	  guint8 dirs[255];
+	  gint count = 0;
+
+	  base = FRIBIDI_TYPE_N;
+	  fribidi_log2vis_get_rtl_mask(us, len, &base, rtl_mask);
+
+	  /* The mask that comes with the visual string must be the same */
+	  base = FRIBIDI_TYPE_N;
+	  fribidi_log2vis_rtl_mask(us, len, &base, vis_us, NULL, NULL, NULL,
+				   vis_rtl_mask);
+	  for (i=0; i<(len + 63) / 64; i++)
+	    if (vis_rtl_mask[i] != rtl_mask[i])
+	      printf("Mask mismatch at word %d\n", i);
+	  for (i=0; i<len; i++)
+	    if (vis_us[i] != out_us[i])
+	      printf("Mask visual mismatch at %d\n", i);
+	  printf("rtl %d, changes at",
+		 fribidi_rtl_mask_count(rtl_mask, 0, len));
+	  for (i=0; i<len; i=fribidi_rtl_mask_next_change(rtl_mask, len, i))
+	    printf(" %d", i);
+	  printf("\n");
+
+	  /* The queries must agree with the embedding levels */
+	  fribidi_rtl_mask_expand(rtl_mask, len, dirs);
+	  for (i=len-1; i>=0; i--)
+	    {
+	      count += embedding_list[i] % 2;
+	      if (dirs[i] != embedding_list[i] % 2
+		  || fribidi_rtl_mask_count(rtl_mask, i, len) != count)
+		printf("Direction mismatch at %d\n", i);
+	    }
+	}
+      drain_trace(do_debug, trace_file);
     }
+
+  if (trace_file)
+    fclose(trace_file);
+  g_free(binary);
   
   return 0;
 }